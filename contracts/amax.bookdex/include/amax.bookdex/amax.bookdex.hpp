@@ -60,6 +60,12 @@ class [[eosio::contract("amax.bookdex")]] bookdex : public contract {
 
    [[eosio::on_notify("*::transfer")]]
    void ontransfer(const name& from, const name& to, const asset& quantity, const string& memo);
+
+   [[eosio::on_notify("*::transfers")]]
+   void ontransfers(const name& from, const vector<transfer_item>& transfers);
+
+   [[eosio::on_notify("*::claimairdrop")]]
+   void onclaimairdrop();
  
    ACTION addtradepair(const extended_symbol& base_symb, const extended_symbol& quote_symb, 
                        const float& maker_fee_rate, const float& taker_fee_rate);
@@ -27,6 +27,17 @@ namespace eosio {
 
    using std::string;
 
+   /**
+    * One payment of a `transfers` batch: `quantity` tokens sent to `to` with `memo`.
+    */
+   struct transfer_item {
+      name     to;
+      asset    quantity;
+      string   memo;
+
+      EOSLIB_SERIALIZE( transfer_item, (to)(quantity)(memo) )
+   };
+
    /**
     * amax.token contract defines the structures and actions that allow users to create, issue, and manage
     * tokens on eosio based blockchains.
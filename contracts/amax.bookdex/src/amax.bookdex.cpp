@@ -83,6 +83,27 @@ using namespace std;
       }
    }
 
+   /**
+    * @brief batched payments of `transfers`, each one to this contract is handled as a transfer
+    */
+   [[eosio::on_notify("*::transfers")]]
+   void bookdex::ontransfers(const name& from, const vector<transfer_item>& transfers) {
+      if (from == get_self()) return;
+
+      for (const auto& t : transfers) {
+         if (t.to == get_self())
+            ontransfer(from, t.to, t.quantity, t.memo);
+      }
+   }
+
+   /**
+    * @brief airdrop claims carry no memo with an order to place, so they are refused
+    */
+   [[eosio::on_notify("*::claimairdrop")]]
+   void bookdex::onclaimairdrop() {
+      CHECKC( false, err::PARAM_ERROR, "airdrops can not be claimed to bookdex" )
+   }
+
    void bookdex::addtradepair(const extended_symbol& base_symb, const extended_symbol& quote_symb, const float& maker_fee_rate, const float& taker_fee_rate) {
       auto tradepair = trade_pair_t::idx_t(_self, _self.value);
       tradepair.emplace(_self, [&]( auto& row ){
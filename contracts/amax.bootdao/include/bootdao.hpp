@@ -24,8 +24,46 @@ public:
     ACTION init();
     ACTION recycle(const vector<name>& accounts);
 
+    /**
+     * queue accounts for recycling, processed later by recyclestep in bounded slices,
+     * accounts already in the queue are skipped
+     */
+    ACTION addrecycle(const vector<name>& accounts);
+
+    /**
+     * recycle up to `max` queued accounts, anyone can push the queue forward
+     * each account is recycled by recycleone in a deferred transaction of its own,
+     * so that one failing account can not abort the slice nor block the queue
+     */
+    ACTION recyclestep(const uint32_t& max);
+
+    /**
+     * recycle one account dequeued by recyclestep
+     */
+    ACTION recycleone(const name& account);
+
+    /**
+     * a failed recycleone transaction is logged by recyclelog with a "failed" result
+     */
+    [[eosio::on_notify("amax::onerror")]]
+    void onerror(const uint128_t& sender_id, const vector<char>& sent_trx);
+
+    /**
+     * per-account result receipt of recyclestep
+     */
+    ACTION recyclelog(const name& account, const string& result, const asset& net_bw, const asset& cpu_bw,
+                      const int64_t& ram_bytes, const asset& balance);
+    using recyclelog_action = eosio::action_wrapper<"recyclelog"_n, &bootdao::recyclelog>;
+
 private:
-    void recycle_account(const name& account);
+    struct recycle_result {
+        asset   net_bw;
+        asset   cpu_bw;
+        int64_t ram_bytes = 0;
+        asset   balance;
+    };
+
+    string recycle_account(const name& account, recycle_result& result);
     asset get_balance(const name& bank, const symbol& symb, const name& account);
 
    struct accounts {
@@ -32,6 +32,25 @@ NTBL("global") global_t {
 };
 typedef eosio::singleton< "global"_n, global_t > global_singleton;
 
+//accounts queued for recycling, processed in id order by recyclestep
+NTBL("recycleq") recycle_queue_t {
+    uint64_t        id;
+    name            account;
+    time_point_sec  queued_at;
+
+    recycle_queue_t() {}
+    recycle_queue_t(const uint64_t& i): id(i) {}
+
+    uint64_t primary_key()const { return id; }
+    uint64_t by_account()const { return account.value; }
+
+    typedef eosio::multi_index<"recycleq"_n, recycle_queue_t,
+        indexed_by<"accountidx"_n, const_mem_fun<recycle_queue_t, uint64_t, &recycle_queue_t::by_account> >
+    > idx_t;
+
+    EOSLIB_SERIALIZE( recycle_queue_t, (id)(account)(queued_at) )
+};
+
 
 
 } }
\ No newline at end of file
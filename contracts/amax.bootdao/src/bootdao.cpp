@@ -4,6 +4,8 @@
 
 #include <amax.system/amax.system.hpp>
 
+#include <eosio/transaction.hpp>
+
 #include <chrono>
 
 using namespace wasm;
@@ -27,6 +29,12 @@ using undelegatebw_action = eosio::action_wrapper<"undelegatebw"_n, &system_cont
             system_contract::sellram_action( "amax"_n, {{get_self(), active_permission}}) \
             .send( from, rambytes );
 
+#define RECYCLE_LOG(account, result, res) \
+            bootdao::recyclelog_action( get_self(), {{get_self(), active_permission}}) \
+            .send( account, result, res.net_bw, res.cpu_bw, res.ram_bytes, res.balance );
+
+static constexpr uint32_t max_recycle_step  = 50;
+
 [[eosio::action]]
 void bootdao::init() {
     auto& acct = _gstate.whitelist_accounts;
@@ -46,16 +54,87 @@ void bootdao::recycle(const vector<name>& accounts) {
     require_auth(get_self());
 
     for( auto& account: accounts ){
-        recycle_account( account );
+        recycle_result res;
+        auto err = recycle_account( account, res );
+        check( err.empty(), err );
+    }
+}
+
+void bootdao::addrecycle(const vector<name>& accounts) {
+    require_auth(get_self());
+    check( accounts.size() > 0, "empty accounts" );
+
+    auto queue = recycle_queue_t::idx_t(get_self(), get_self().value);
+    auto queued = queue.get_index<"accountidx"_n>();
+    auto id = queue.available_primary_key();
+    auto now = time_point_sec( current_time_point() );
+    for( auto& account: accounts ){
+        if ( queued.find( account.value ) != queued.end() )
+            continue;
+
+        queue.emplace( get_self(), [&]( auto& q ) {
+            q.id        = id++;
+            q.account   = account;
+            q.queued_at = now;
+        });
+    }
+}
+
+void bootdao::recyclestep(const uint32_t& max) {
+    check( max > 0 && max <= max_recycle_step, "max must be in (0, " + to_string(max_recycle_step) + "]" );
+
+    auto queue = recycle_queue_t::idx_t(get_self(), get_self().value);
+    auto itr = queue.begin();
+    check( itr != queue.end(), "recycle queue is empty" );
+
+    for( uint32_t i = 0; i < max && itr != queue.end(); i++ ){
+        eosio::transaction trx;
+        trx.actions.emplace_back( permission_level{ get_self(), active_permission }, get_self(), "recycleone"_n,
+                                  std::make_tuple( itr->account ) );
+        trx.send( (uint128_t(itr->account.value) << 64) | itr->id, get_self() );
+
+        itr = queue.erase( itr );
     }
 }
 
-void bootdao::recycle_account(const name& account) {
-    check( _gstate.whitelist_accounts.find(account) == _gstate.whitelist_accounts.end(), "whitelisted" );
+void bootdao::recycleone(const name& account) {
+    require_auth(get_self());
+
+    recycle_result res;
+    auto err = recycle_account( account, res );
+    RECYCLE_LOG( account, err.empty() ? "recycled" : err, res )
+}
+
+void bootdao::onerror(const uint128_t& sender_id, const vector<char>& sent_trx) {
+    require_auth(get_self());
+
+    recycle_result res;
+    res.net_bw  = asset(0, SYS_SYMB);
+    res.cpu_bw  = asset(0, SYS_SYMB);
+    res.balance = asset(0, SYS_SYMB);
+    RECYCLE_LOG( name(uint64_t(sender_id >> 64)), "failed", res )
+}
+
+void bootdao::recyclelog(const name& account, const string& result, const asset& net_bw, const asset& cpu_bw,
+                         const int64_t& ram_bytes, const asset& balance) {
+    require_auth(get_self());
+}
+
+/**
+ * returns an error message when the account can not be recycled, otherwise recycles it and fills `result`
+ */
+string bootdao::recycle_account(const name& account, recycle_result& result) {
+    result.net_bw  = asset(0, SYS_SYMB);
+    result.cpu_bw  = asset(0, SYS_SYMB);
+    result.balance = asset(0, SYS_SYMB);
+
+    if ( _gstate.whitelist_accounts.find(account) != _gstate.whitelist_accounts.end() )
+        return "whitelisted";
 
     user_resources_table  userres( "amax"_n, account.value );
     auto res_itr = userres.find( account.value );
-    check( res_itr !=  userres.end(), "account res not found: " + account.to_string() );
+    if ( res_itr == userres.end() )
+        return "account res not found: " + account.to_string();
 
     auto net_bw = asset(200000, SYS_SYMB);
     auto cpu_bw = asset(200000, SYS_SYMB);
@@ -87,6 +166,12 @@ void bootdao::recycle_account(const name& account) {
     // check(false, "amax bal: " + amax_bal.to_string() );
     if (amax_bal.amount > 0)
         FORCE_TRANSFER( AMAX_BANK, account, "amax"_n, amax_bal, "" )
+
+    result.net_bw    = net_bw;
+    result.cpu_bw    = cpu_bw;
+    result.ram_bytes = rambytes > 4000 ? rambytes - 4000 : 0;
+    result.balance   = amax_bal;
+    return "";
 }
 
 asset bootdao::get_balance(const name& bank, const symbol& symb, const name& account) {
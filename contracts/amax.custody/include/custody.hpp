@@ -49,6 +49,14 @@ public:
      *    @param quantity - issued quantity
      */
     [[eosio::on_notify("*::transfer")]] void ontransfer(name from, name to, asset quantity, string memo);
+    /**
+     * each payment of a transfers() batch to contract self is handled as by ontransfer()
+     */
+    [[eosio::on_notify("*::transfers")]] void ontransfers(name from, vector<transfer_item> transfers);
+    /**
+     * airdrop claims carry no memo with a plan or an issue, they are refused
+     */
+    [[eosio::on_notify("*::claimairdrop")]] void onclaimairdrop();
     [[eosio::action]] void unlock(const name& unlocker, const uint64_t& plan_id, const uint64_t& issue_id);
     /**
      * @require run by issuer only
@@ -228,6 +228,18 @@ void custody::ontransfer(name from, name to, asset quantity, string memo) {
     // else { ignore }
 }
 
+//batched issue-in op: each payment of transfers() to the contract is handled as a transfer
+void custody::ontransfers(name from, vector<transfer_item> transfers) {
+    for (const auto& t : transfers) {
+        if (t.to == get_self())
+            ontransfer(from, t.to, t.quantity, t.memo);
+    }
+}
+
+void custody::onclaimairdrop() {
+    CHECK( false, "airdrops can not be claimed to custody" )
+}
+
 [[eosio::action]]
 void custody::endissue(const name& issuer, const uint64_t& plan_id, const uint64_t& issue_id) {
     require_auth( issuer );
@@ -1,5 +1,6 @@
 #include <eosio/asset.hpp>
 #include <eosio/eosio.hpp>
+#include <algorithm>
 #include <string>
 
 #include "mulsign_db.hpp"
@@ -121,25 +122,38 @@ public:
    ACTION setmulsigner(const name& issuer, const uint64_t& wallet_id, const name& mulsigner, const uint32_t& weight) {
       require_auth( issuer );
 
+      auto wallets = wallet_t::idx_t(_self, _self.value);
       auto wallet = wallet_t(wallet_id);
-      CHECKC( _db.get(wallet), err::RECORD_NOT_FOUND, "wallet not found: " + to_string(wallet_id) )
+      auto wallet_itr = _db.find( wallets, wallet );
+      CHECKC( wallet_itr != wallets.end(), err::RECORD_NOT_FOUND, "wallet not found: " + to_string(wallet_id) )
       CHECKC( wallet.creator == issuer, err::NO_AUTH, "only creator allowed to add cosinger: " + wallet.creator.to_string() )
       int64_t elapsed =  current_time_point().sec_since_epoch() - wallet.created_at.sec_since_epoch();
       CHECKC( elapsed < seconds_per_day, err::TIME_EXPIRED, "setmulsigner exceeded 24-hour time window" )
       CHECKC( is_account(mulsigner), err::ACCOUNT_INVALID, "invalid mulsigner: " + mulsigner.to_string() )
       CHECKC( weight > 0, err::PARAM_ERROR, "weight must be positive")
-
-
-      wallet.mulsigners[mulsigner] = weight;
+      migrate_wallet( wallets, wallet_itr, wallet );
+
+      auto signers = wallet_signer_t::idx_t(_self, wallet_id);
+      auto signer_itr = signers.find( mulsigner.value );
+      if (signer_itr == signers.end()) {
+         signers.emplace( issuer, [&]( auto& s ) {
+            s.mulsigner = mulsigner;
+            s.weight = weight;
+         });
+      } else {
+         signers.modify( signer_itr, same_payer, [&]( auto& s ) {
+            s.weight = weight;
+         });
+      }
 
       uint32_t total_weight = 0;
-      for (const auto& item : wallet.mulsigners) {
-         total_weight += item.second;
+      for (const auto& item : signers) {
+         total_weight += item.weight;
       }
       CHECKC( total_weight <= wallet.mulsign_n, err::OVERSIZED, "total weight is oversize than n: " + to_string(wallet.mulsign_n) );
 
       wallet.updated_at = time_point_sec( current_time_point() );
-      _db.set( wallet, issuer );
+      _db.set( wallets, wallet_itr, wallet, issuer );
    }
 
    /**
@@ -152,12 +166,15 @@ public:
    ACTION setwapexpiry(const name& issuer, const uint64_t wallet_id, const uint64_t& expiry_sec) {
       require_auth( issuer );
 
+      auto wallets = wallet_t::idx_t(_self, _self.value);
       auto wallet = wallet_t(wallet_id);
-      CHECKC( _db.get(wallet), err::RECORD_NOT_FOUND, "wallet not found: " + to_string(wallet_id) )
+      auto wallet_itr = _db.find( wallets, wallet );
+      CHECKC( wallet_itr != wallets.end(), err::RECORD_NOT_FOUND, "wallet not found: " + to_string(wallet_id) )
       CHECKC( wallet.creator == issuer, err::NO_AUTH, "only creator allowed to add cosinger: " + wallet.creator.to_string() )
+      migrate_wallet( wallets, wallet_itr, wallet );
 
       wallet.proposal_expiry_sec = expiry_sec;
-      _db.set( wallet, issuer );
+      _db.set( wallets, wallet_itr, wallet, issuer );
    }
 
    /**
@@ -171,8 +188,10 @@ public:
    ACTION delmulsigner(const name& issuer, const uint64_t& wallet_id, const name& mulsigner) {
       require_auth( issuer );
 
+      auto wallets = wallet_t::idx_t(_self, _self.value);
       auto wallet = wallet_t(wallet_id);
-      CHECKC( _db.get( wallet ), err::RECORD_NOT_FOUND, "wallet not found: " + to_string(wallet_id) )
+      auto wallet_itr = _db.find( wallets, wallet );
+      CHECKC( wallet_itr != wallets.end(), err::RECORD_NOT_FOUND, "wallet not found: " + to_string(wallet_id) )
       CHECKC( issuer == mulsigner || issuer == wallet.creator, err::NO_AUTH, "unauthorized" )
 
       if (issuer == wallet.creator) {
@@ -182,9 +201,15 @@ public:
          CHECKC( elapsed < seconds_per_day, err::TIME_EXPIRED, "owner to delmulsigner exceeded 24-hour time window")
       }
 
-      wallet.mulsigners.erase(mulsigner);
+      migrate_wallet( wallets, wallet_itr, wallet );
+
+      auto signers = wallet_signer_t::idx_t(_self, wallet_id);
+      auto signer_itr = signers.find( mulsigner.value );
+      if (signer_itr != signers.end())
+         signers.erase( signer_itr );
+
       wallet.updated_at = time_point_sec( current_time_point() );
-      _db.set( wallet, issuer );
+      _db.set( wallets, wallet_itr, wallet, issuer );
 
    }
 
@@ -232,6 +257,28 @@ public:
       }
    }
 
+   /**
+    * @brief batched payments of `transfers`, each one to this contract is handled as a transfer
+    *
+    * @param from
+    * @param transfers
+    */
+   [[eosio::on_notify("*::transfers")]]
+   void ontransfers(const name& from, const vector<transfer_item>& transfers) {
+      for (const auto& t : transfers) {
+         if (t.to == get_self())
+            ontransfer(from, t.to, t.quantity, t.memo);
+      }
+   }
+
+   /**
+    * @brief airdrop claims carry no memo telling the wallet to lock into, so they are refused
+    */
+   [[eosio::on_notify("*::claimairdrop")]]
+   void onclaimairdrop() {
+      CHECKC( false, err::PARAM_ERROR, "airdrops can not be claimed to mulsign" )
+   }
+
    /**
     * @brief fee collect action
     *
@@ -256,15 +303,21 @@ public:
       require_auth( issuer );
 
       const auto& now = current_time_point();
+      auto wallets = wallet_t::idx_t(_self, _self.value);
       auto wallet = wallet_t(wallet_id);
+      auto wallet_itr = _db.find( wallets, wallet );
       const auto& symb = ex_asset.get_extended_symbol();
-      CHECKC( _db.get( wallet ), err::RECORD_NOT_FOUND, "wallet not found: " + to_string(wallet_id) )
-      CHECKC( wallet.assets.count(symb), err::PARAM_ERROR,
+      CHECKC( wallet_itr != wallets.end(), err::RECORD_NOT_FOUND, "wallet not found: " + to_string(wallet_id) )
+      migrate_wallet( wallets, wallet_itr, wallet );
+
+      auto wallet_assets = wallet_asset_t::idx_t(_self, wallet_id);
+      auto wallet_asset = find_wallet_asset( wallet_assets, symb );
+      CHECKC( wallet_asset != nullptr, err::PARAM_ERROR,
          "symbol does not found in wallet: " + to_string(ex_asset) )
       CHECKC( ex_asset.quantity.amount > 0, err::PARAM_ERROR, "withdraw quantity must be positive" )
       CHECKC( is_account(recipient), err::ACCOUNT_INVALID, "recipient account does not exist" );
 
-      auto avail_quant = wallet.assets[ symb ];
+      auto avail_quant = wallet_asset->amount;
       CHECKC( ex_asset.quantity.amount <= avail_quant, err::OVERSIZED, "overdrawn proposal: " + ex_asset.quantity.to_string() + " > " + to_string(avail_quant) )
 
       CHECKC( transfer_memo.length() < 256, err::OVERSIZED, "transfer_memo length >= 256" )
@@ -272,7 +325,8 @@ public:
       CHECKC( meta_url.length() < 2048, err::OVERSIZED, "meta_url length >= 2048" )
 
       auto proposals = proposal_t::idx_t(_self, _self.value);
-      auto pid = proposals.available_primary_key();
+      auto pid = std::max( _gstate.next_proposal_id.value_or(0), proposals.available_primary_key() );
+      _gstate.next_proposal_id.emplace( pid + 1 );
       auto proposal = proposal_t(pid);
       proposal.wallet_id = wallet_id;
       proposal.quantity = ex_asset;
@@ -286,7 +340,8 @@ public:
       proposal.expired_at = proposal.created_at + wallet.proposal_expiry_sec;
       proposal.status = proposal_status::PROPOSED;
 
-      _db.set(proposal, issuer);
+      _db.set( proposals, proposals.end(), proposal, issuer );
+      update_open_proposal( proposal, issuer );
    }
 
 /**
@@ -297,8 +352,10 @@ ACTION cancel(const name& issuer, const uint64_t& proposal_id) {
    require_auth( issuer );
 
    const auto& now = current_time_point();
+   auto proposals = proposal_t::idx_t(_self, _self.value);
    auto proposal = proposal_t(proposal_id);
-   CHECKC( _db.get( proposal ), err::RECORD_NOT_FOUND, "proposal not found: " + to_string(proposal_id) )
+   auto proposal_itr = _db.find( proposals, proposal );
+   CHECKC( proposal_itr != proposals.end(), err::RECORD_NOT_FOUND, "proposal not found: " + to_string(proposal_id) )
    CHECKC( proposal.proposer == issuer, err::NO_AUTH, "issuer is not proposer" )
    CHECKC( proposal.status == proposal_status::PROPOSED, err::STATUS_ERROR,
            "proposal can not be canceled at status: " + proposal.status.to_string() )
@@ -307,7 +364,8 @@ ACTION cancel(const name& issuer, const uint64_t& proposal_id) {
 
    proposal.updated_at = now;
    proposal.status = proposal_status::CANCELED;
-   _db.set( proposal );
+   _db.set( proposals, proposal_itr, proposal, same_payer );
+   update_open_proposal( proposal, issuer );
 }
 
 /**
@@ -318,47 +376,155 @@ ACTION cancel(const name& issuer, const uint64_t& proposal_id) {
 ACTION approve(const name& issuer, const uint64_t& proposal_id) {
    require_auth( issuer );
 
-   const auto& now = current_time_point();
-   auto proposal = proposal_t(proposal_id);
-   CHECKC( _db.get( proposal ), err::RECORD_NOT_FOUND, "proposal not found: " + to_string(proposal_id) )
-   CHECKC( proposal.status == proposal_status::PROPOSED || proposal.status == proposal_status::APPROVED,
-            err::STATUS_ERROR, "proposal can not be approved at status: " + proposal.status.to_string() )
-   CHECKC( proposal.expired_at >= current_time_point(), err::TIME_EXPIRED, "the proposal already expired" )
-   CHECKC( !proposal.approvers.count(issuer), err::ACTION_REDUNDANT, "issuer (" + issuer.to_string() +") already approved" )
+   auto proposals = proposal_t::idx_t(_self, _self.value);
+   auto wallets = wallet_t::idx_t(_self, _self.value);
+   approve_proposal( issuer, proposals, wallets, proposal_id, false );
+}
 
-   auto wallet = wallet_t(proposal.wallet_id);
-   CHECKC( _db.get( wallet ), err::RECORD_NOT_FOUND, "wallet not found: " + to_string(proposal.wallet_id) )
-   CHECKC( wallet.mulsigners.count(issuer), err::NO_AUTH, "issuer (" + issuer.to_string() +") not allowed to approve" )
+/**
+ * @brief approve a batch of proposals in one go, wallets shared among them are only read once
+ * @param issuer - mulsigner
+ * @param proposal_ids - proposals to approve, max_approve_batch_size at most
+ * @param execute - execute right away those proposals reaching their wallet's mulsign_m threshold
+ */
+ACTION approvebatch(const name& issuer, const vector<uint64_t>& proposal_ids, const bool& execute) {
+   require_auth( issuer );
 
-   proposal.approvers.insert(issuer);
-   proposal.recv_votes += wallet.mulsigners[issuer];
-   proposal.updated_at = now;
-   proposal.status = proposal_status::APPROVED;
+   CHECKC( proposal_ids.size() > 0, err::PARAM_ERROR, "empty proposal_ids" )
+   CHECKC( proposal_ids.size() <= max_approve_batch_size, err::OVERSIZED,
+           "proposal_ids size > " + to_string(max_approve_batch_size) )
 
-   _db.set(proposal, issuer);
+   auto proposals = proposal_t::idx_t(_self, _self.value);
+   auto wallets = wallet_t::idx_t(_self, _self.value);
+   for (const auto& proposal_id : proposal_ids) {
+      approve_proposal( issuer, proposals, wallets, proposal_id, execute );
+   }
 }
 
 ACTION execute(const name& issuer, const uint64_t& proposal_id) {
    require_auth( issuer );
    const auto& now = current_time_point();
+   auto proposals = proposal_t::idx_t(_self, _self.value);
    auto proposal = proposal_t(proposal_id);
-   CHECKC( _db.get( proposal ), err::RECORD_NOT_FOUND, "proposal not found: " + to_string(proposal_id) )
-   CHECKC( proposal.status == proposal_status::PROPOSED, err::STATUS_ERROR,
-           "proposal can not be executed at status: " + proposal.status.to_string() )
+   auto proposal_itr = _db.find( proposals, proposal );
+   CHECKC( proposal_itr != proposals.end(), err::RECORD_NOT_FOUND, "proposal not found: " + to_string(proposal_id) )
+   CHECKC( proposal.status == proposal_status::PROPOSED || proposal.status == proposal_status::APPROVED,
+           err::STATUS_ERROR, "proposal can not be executed at status: " + proposal.status.to_string() )
    CHECKC( proposal.expired_at >= now, err::TIME_EXPIRED, "the proposal already expired" )
 
+   auto wallets = wallet_t::idx_t(_self, _self.value);
    auto wallet = wallet_t(proposal.wallet_id);
-   CHECKC( _db.get( wallet ), err::RECORD_NOT_FOUND, "wallet not found: " + to_string(proposal.wallet_id) )
+   auto wallet_itr = _db.find( wallets, wallet );
+   CHECKC( wallet_itr != wallets.end(), err::RECORD_NOT_FOUND, "wallet not found: " + to_string(proposal.wallet_id) )
+   migrate_wallet( wallets, wallet_itr, wallet );
    CHECKC( proposal.recv_votes >= wallet.mulsign_m, err::NO_AUTH, "insufficient votes" )
 
    execute_proposal(wallet, proposal);
    proposal.updated_at = now;
    proposal.status = proposal_status::EXECUTED;
-   _db.set(proposal);
+   _db.set( proposals, proposal_itr, proposal, same_payer );
+   update_open_proposal( proposal, issuer );
+}
+
+/**
+ * @brief anyone can sweep expired, executed or canceled proposals, releasing their RAM
+ *        each sweep resumes where the previous one stopped, wrapping around at the end of the table,
+ *        so that open proposals are examined once per round only
+ * @param max - max number of proposals to examine, no more than max_sweep_size
+ */
+ACTION sweep(const uint32_t& max) {
+   CHECKC( max > 0 && max <= max_sweep_size, err::PARAM_ERROR, "max must be in (0, " + to_string(max_sweep_size) + "]" )
+
+   const auto& now = current_time_point();
+   auto proposals = proposal_t::idx_t(_self, _self.value);
+   // binary extensions serialize in order: next_proposal_id must be present before sweep_cursor is stored,
+   // and it is taken before erasing so that the ids of swept proposals are not handed out again
+   _gstate.next_proposal_id.emplace( std::max( _gstate.next_proposal_id.value_or(0), proposals.available_primary_key() ) );
+   auto itr = proposals.lower_bound( _gstate.sweep_cursor.value_or(0) );
+   for (uint32_t i = 0; i < max && itr != proposals.end(); i++) {
+      bool open = itr->status == proposal_status::PROPOSED || itr->status == proposal_status::APPROVED;
+      if (open && itr->expired_at >= now) {
+         itr++;
+         continue;
+      }
+
+      auto open_proposals = open_proposal_t::idx_t(_self, itr->wallet_id);
+      auto open_itr = open_proposals.find( itr->id );
+      if (open_itr != open_proposals.end())
+         open_proposals.erase( open_itr );
+
+      itr = proposals.erase( itr );
+   }
+   _gstate.sweep_cursor.emplace( itr == proposals.end() ? 0 : itr->id );
 }
 
 private:
 
+   /**
+    * @brief approve a proposal by a mulsigner, wallet rows are served from the `wallets` cache
+    *        when approving several proposals of the same wallet
+    * @param auto_execute - execute the proposal once its received votes reach mulsign_m
+    */
+   void approve_proposal(const name& issuer, proposal_t::idx_t& proposals, wallet_t::idx_t& wallets,
+                         const uint64_t& proposal_id, const bool& auto_execute) {
+      const auto& now = current_time_point();
+      auto proposal = proposal_t(proposal_id);
+      auto proposal_itr = _db.find( proposals, proposal );
+      CHECKC( proposal_itr != proposals.end(), err::RECORD_NOT_FOUND, "proposal not found: " + to_string(proposal_id) )
+      CHECKC( proposal.status == proposal_status::PROPOSED || proposal.status == proposal_status::APPROVED,
+               err::STATUS_ERROR, "proposal can not be approved at status: " + proposal.status.to_string() )
+      CHECKC( proposal.expired_at >= now, err::TIME_EXPIRED, "the proposal already expired" )
+      CHECKC( !proposal.approvers.count(issuer), err::ACTION_REDUNDANT, "issuer (" + issuer.to_string() +") already approved" )
+
+      auto wallet = wallet_t(proposal.wallet_id);
+      auto wallet_itr = _db.find( wallets, wallet );
+      CHECKC( wallet_itr != wallets.end(), err::RECORD_NOT_FOUND, "wallet not found: " + to_string(proposal.wallet_id) )
+      migrate_wallet( wallets, wallet_itr, wallet );
+
+      auto signer = wallet_signer_t(issuer);
+      CHECKC( _db.get( proposal.wallet_id, signer ), err::NO_AUTH, "issuer (" + issuer.to_string() +") not allowed to approve" )
+
+      proposal.approvers.insert(issuer);
+      proposal.recv_votes += signer.weight;
+      proposal.updated_at = now;
+      proposal.status = proposal_status::APPROVED;
+
+      if (auto_execute && proposal.recv_votes >= wallet.mulsign_m) {
+         execute_proposal(wallet, proposal);
+         proposal.status = proposal_status::EXECUTED;
+      }
+
+      _db.set( proposals, proposal_itr, proposal, issuer );
+      update_open_proposal( proposal, issuer );
+   }
+
+   /**
+    * @brief keep the wallet-scoped open proposal index in line with the proposal status,
+    *        closed proposals are dropped out of it
+    */
+   void update_open_proposal(const proposal_t& proposal, const name& payer) {
+      auto open_proposals = open_proposal_t::idx_t(_self, proposal.wallet_id);
+      auto itr = open_proposals.find( proposal.id );
+
+      if (proposal.status != proposal_status::PROPOSED && proposal.status != proposal_status::APPROVED) {
+         if (itr != open_proposals.end())
+            open_proposals.erase( itr );
+         return;
+      }
+
+      if (itr == open_proposals.end()) {
+         open_proposals.emplace( payer, [&]( auto& p ) {
+            p.proposal_id  = proposal.id;
+            p.status       = proposal.status;
+            p.expired_at   = proposal.expired_at;
+         });
+      } else if (itr->status != proposal.status) {
+         open_proposals.modify( itr, same_payer, [&]( auto& p ) {
+            p.status       = proposal.status;
+         });
+      }
+   }
+
    void create_wallet(const name& creator, const uint32_t& m, const uint32_t& n, const string& title) {
       auto mwallets = wallet_t::idx_t(_self, _self.value);
       auto wallet_id = mwallets.available_primary_key();
@@ -373,37 +539,86 @@ private:
       wallet.creator = creator;
       wallet.created_at = time_point_sec(current_time_point());
 
-      _db.set( wallet, _self );
+      _db.set( mwallets, mwallets.end(), wallet, _self );
 
    }
 
    void lock_funds(const uint64_t& wallet_id, const name& bank_contract, const asset& quantity) {
+      auto wallets = wallet_t::idx_t(_self, _self.value);
       auto wallet = wallet_t(wallet_id);
-      CHECKC( _db.get( wallet ), err::RECORD_NOT_FOUND, "wallet not found: " + to_string(wallet_id) )
+      auto wallet_itr = _db.find( wallets, wallet );
+      CHECKC( wallet_itr != wallets.end(), err::RECORD_NOT_FOUND, "wallet not found: " + to_string(wallet_id) )
+      migrate_wallet( wallets, wallet_itr, wallet );
 
-      const auto& symb = extended_symbol(quantity.symbol, bank_contract);
-      wallet.assets[ symb ] += quantity.amount;
-      _db.set( wallet, _self );
+      add_wallet_asset( wallet_id, extended_symbol(quantity.symbol, bank_contract), quantity.amount );
    }
 
    void execute_proposal(wallet_t& wallet, proposal_t &proposal) {
       const auto& symb = proposal.quantity.get_extended_symbol();
-      auto avail_quant = wallet.assets[ symb ];
+      auto wallet_assets = wallet_asset_t::idx_t(_self, wallet.id);
+      auto wallet_asset = find_wallet_asset( wallet_assets, symb );
+      auto avail_quant = (wallet_asset != nullptr) ? wallet_asset->amount : 0;
       CHECKC( proposal.quantity.quantity.amount <= avail_quant, err::OVERSIZED, "Overdrawn not allowed: " + proposal.quantity.quantity.to_string() + " > " + to_string(avail_quant) );
 
       if (proposal.quantity.quantity.amount == avail_quant) {
-         wallet.assets.erase(symb);
+         wallet_assets.erase( *wallet_asset );
       } else {
-         wallet.assets[ symb ] -= proposal.quantity.quantity.amount;
+         wallet_assets.modify( *wallet_asset, same_payer, [&]( auto& a ) {
+            a.amount -= proposal.quantity.quantity.amount;
+         });
       }
 
-      _db.set(wallet);
-
       auto asset_bank = proposal.quantity.contract;
       auto memo = (proposal.transfer_memo != "") ? proposal.transfer_memo : "mulsign execute";
 
       TRANSFER( asset_bank, proposal.recipient, proposal.quantity.quantity, memo )
    }
 
+   const wallet_asset_t* find_wallet_asset(wallet_asset_t::idx_t& wallet_assets, const extended_symbol& symb) {
+      auto symb_idx = wallet_assets.get_index<"symbidx"_n>();
+      auto itr = symb_idx.find( make128key(symb.get_contract().value, symb.get_symbol().raw()) );
+      return (itr == symb_idx.end()) ? nullptr : &(*itr);
+   }
+
+   void add_wallet_asset(const uint64_t& wallet_id, const extended_symbol& symb, const int64_t& amount) {
+      auto wallet_assets = wallet_asset_t::idx_t(_self, wallet_id);
+      auto wallet_asset = find_wallet_asset( wallet_assets, symb );
+      if (wallet_asset == nullptr) {
+         wallet_assets.emplace( _self, [&]( auto& a ) {
+            a.id     = wallet_assets.available_primary_key();
+            a.symb   = symb;
+            a.amount = amount;
+         });
+      } else {
+         wallet_assets.modify( *wallet_asset, same_payer, [&]( auto& a ) {
+            a.amount += amount;
+         });
+      }
+   }
+
+   /**
+    * @brief move legacy inline signers & assets of a wallet row into their own tables
+    *
+    */
+   void migrate_wallet(wallet_t::idx_t& wallets, const wallet_t::idx_t::const_iterator& wallet_itr, wallet_t& wallet) {
+      if (wallet.mulsigners.empty() && wallet.assets.empty()) return;
+
+      auto signers = wallet_signer_t::idx_t(_self, wallet.id);
+      for (const auto& item : wallet.mulsigners) {
+         signers.emplace( _self, [&]( auto& s ) {
+            s.mulsigner = item.first;
+            s.weight    = item.second;
+         });
+      }
+
+      for (const auto& item : wallet.assets) {
+         add_wallet_asset( wallet.id, item.first, item.second );
+      }
+
+      wallet.mulsigners.clear();
+      wallet.assets.clear();
+      _db.set( wallets, wallet_itr, wallet, same_payer );
+   }
+
 };
 }
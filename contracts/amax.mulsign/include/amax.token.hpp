@@ -23,6 +23,17 @@ namespace amax {
 
    using std::string;
 
+   /**
+    * One payment of a `transfers` batch: `quantity` tokens sent to `to` with `memo`.
+    */
+   struct transfer_item {
+      name     to;
+      asset    quantity;
+      string   memo;
+
+      EOSLIB_SERIALIZE( transfer_item, (to)(quantity)(memo) )
+   };
+
    /**
     * eosio.token contract defines the structures and actions that allow users to create, issue, and manage
     * tokens on eosio based blockchains.
@@ -1,6 +1,7 @@
  #pragma once
 
 #include <eosio/asset.hpp>
+#include <eosio/binary_extension.hpp>
 #include <eosio/privileged.hpp>
 #include <eosio/singleton.hpp>
 #include <eosio/system.hpp>
@@ -28,14 +29,18 @@ using namespace eosio;
 static constexpr name       SYS_BANK              = "amax.token"_n;
 static constexpr symbol     SYS_SYMBOL            = symbol(symbol_code("AMAX"), 8);
 static constexpr uint64_t   seconds_per_day       = 24 * 3600;
+static constexpr uint32_t   max_approve_batch_size = 50;
+static constexpr uint32_t   max_sweep_size        = 100;
 
 struct [[eosio::table("global"), eosio::contract("amax.mulsign")]] global_t {
     name admin;                 // default is contract self
     name fee_collector;         // who creates fee wallet (id = 0)
     asset wallet_fee;
     bool active = false;
+    binary_extension<uint64_t> next_proposal_id;    // ids are never handed out twice, even after a sweep
+    binary_extension<uint64_t> sweep_cursor;        // id of the proposal where the next sweep resumes
 
-    EOSLIB_SERIALIZE( global_t, (admin)(fee_collector)(wallet_fee)(active) )
+    EOSLIB_SERIALIZE( global_t, (admin)(fee_collector)(wallet_fee)(active)(next_proposal_id)(sweep_cursor) )
 };
 typedef eosio::singleton< "global"_n, global_t > global_singleton;
 
@@ -44,8 +49,8 @@ TBL wallet_t {
     string                  title;
     uint32_t                mulsign_m;
     uint32_t                mulsign_n;      // m <= n
-    map<name, uint32_t>     mulsigners;     // mulsigner : weight
-    map<extended_symbol, int64_t>    assets;         // symb@bank_contract  : amount
+    map<name, uint32_t>     mulsigners;     // legacy, moved into `mulsigners` table upon first touch
+    map<extended_symbol, int64_t>    assets; // legacy, moved into `walletassets` table upon first touch
     uint64_t                proposal_expiry_sec = seconds_per_day;
     name                    creator;
     time_point_sec          created_at;
@@ -69,6 +74,42 @@ TBL wallet_t {
     > idx_t;
 };
 
+// scope: wallet_id
+TBL wallet_signer_t {
+    name                    mulsigner;
+    uint32_t                weight;
+
+    uint64_t primary_key()const { return mulsigner.value; }
+
+    wallet_signer_t() {}
+    wallet_signer_t(const name& signer): mulsigner(signer) {}
+
+    EOSLIB_SERIALIZE( wallet_signer_t, (mulsigner)(weight) )
+
+    typedef eosio::multi_index< "mulsigners"_n,  wallet_signer_t > idx_t;
+};
+
+// scope: wallet_id
+TBL wallet_asset_t {
+    uint64_t                id;
+    extended_symbol         symb;           // symb@bank_contract
+    int64_t                 amount;
+
+    uint64_t primary_key()const { return id; }
+
+    wallet_asset_t() {}
+    wallet_asset_t(const uint64_t& aid): id(aid) {}
+
+    uint128_t by_symb()const { return make128key(symb.get_contract().value, symb.get_symbol().raw()); }
+
+    EOSLIB_SERIALIZE( wallet_asset_t, (id)(symb)(amount) )
+
+    typedef eosio::multi_index
+    < "walletassets"_n,  wallet_asset_t,
+        indexed_by<"symbidx"_n, const_mem_fun<wallet_asset_t, uint128_t, &wallet_asset_t::by_symb> >
+    > idx_t;
+};
+
 namespace proposal_status {
     static constexpr name PROPOSED = "proposed"_n;
     static constexpr name APPROVED = "approved"_n;
@@ -109,4 +150,25 @@ TBL proposal_t {
 
 };
 
+// scope: wallet_id, open (proposed/approved) proposals only
+TBL open_proposal_t {
+    uint64_t            proposal_id;
+    name                status;
+    time_point_sec      expired_at;
+
+    uint64_t            primary_key()const { return proposal_id; }
+
+    open_proposal_t() {}
+    open_proposal_t(const uint64_t& pid): proposal_id(pid) {}
+
+    uint128_t by_status()const { return make128key(status.value, proposal_id); }
+
+    EOSLIB_SERIALIZE( open_proposal_t, (proposal_id)(status)(expired_at) )
+
+    typedef eosio::multi_index
+    < "openprops"_n,  open_proposal_t,
+        indexed_by<"statusidx"_n, const_mem_fun<open_proposal_t, uint128_t, &open_proposal_t::by_status> >
+    > idx_t;
+};
+
 }
\ No newline at end of file
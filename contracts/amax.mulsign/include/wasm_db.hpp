@@ -25,19 +25,21 @@ public:
         auto scope = code.value;
 
         typename RecordType::idx_t idx(code, scope);
-        if (idx.find(record.primary_key()) == idx.end())
+        auto itr = idx.find(record.primary_key());
+        if (itr == idx.end())
             return false;
 
-        record = idx.get(record.primary_key());
+        record = *itr;
         return true;
     }
     template<typename RecordType>
     bool get(const uint64_t& scope, RecordType& record) {
         typename RecordType::idx_t idx(code, scope);
-        if (idx.find(record.primary_key()) == idx.end())
+        auto itr = idx.find(record.primary_key());
+        if (itr == idx.end())
             return false;
 
-        record = idx.get(record.primary_key());
+        record = *itr;
         return true;
     }
   
@@ -123,6 +125,44 @@ public:
         }
     }
 
+    /**
+     * get-or-null within a caller-held index: loads `record` when found and
+     * returns the iterator as a hint for the follow-up set/del (end() if absent)
+     */
+    template<typename RecordType>
+    auto find(typename RecordType::idx_t& idx, RecordType& record) {
+        auto itr = idx.find(record.primary_key());
+        if (itr != idx.end())
+            record = *itr;
+        return itr;
+    }
+
+    /**
+     * upsert by the iterator hint from find(), no further lookup involved
+     */
+    template<typename RecordType>
+    return_t set(typename RecordType::idx_t& idx, const typename RecordType::idx_t::const_iterator& itr,
+                 const RecordType& record, const name& payer) {
+        if (itr != idx.end()) {
+            idx.modify( itr, payer, [&]( auto& item ) {
+                item = record;
+            });
+            return return_t::MODIFIED;
+        }
+
+        idx.emplace( payer, [&]( auto& item ) {
+            item = record;
+        });
+        return return_t::APPENDED;
+    }
+
+    template<typename IndexType>
+    void del(IndexType& idx, const typename IndexType::const_iterator& itr) {
+        if ( itr != idx.end() ) {
+            idx.erase(itr);
+        }
+    }
+
 };
 
 }}//db//wasm
\ No newline at end of file
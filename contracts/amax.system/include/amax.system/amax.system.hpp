@@ -12,6 +12,7 @@
 #include <amax.system/native.hpp>
 
 #include <deque>
+#include <map>
 #include <optional>
 #include <string>
 #include <type_traits>
@@ -74,6 +75,16 @@ namespace eosiosystem {
    static constexpr int64_t  ram_gift_bytes        = 1400;
 
    static constexpr uint32_t refund_delay_sec      = 3 * seconds_per_day;
+   static constexpr uint32_t max_elected_producers = 21;
+   static constexpr uint32_t max_delegate_batch_size = 100;
+   static constexpr uint32_t max_ram_batch_size      = 100;
+   static constexpr uint32_t max_name_close_batch    = 10;
+   static constexpr uint32_t max_name_close_migration = 50;
+   static constexpr uint16_t rex_maintenance_min_budget = 2;
+   static constexpr uint16_t rex_maintenance_max_budget = 16;
+   static constexpr uint16_t powerup_queue_min_batch    = 2;
+   static constexpr uint16_t powerup_queue_max_batch    = 64;
+   static constexpr uint32_t powerup_curve_segments     = 100;
 
 
   /**
@@ -120,6 +131,31 @@ namespace eosiosystem {
 
    typedef eosio::multi_index< "bidrefunds"_n, bid_refund > bid_refund_table;
 
+   // An open name auction queued for closing, which is defined by:
+   // - the `newname` name the auction is for
+   // - the `close_time` after which the auction can be closed, 24 hours after its latest bid
+   struct [[eosio::table, eosio::contract("amax.system")]] name_close {
+      name         newname;
+      time_point   close_time;
+
+      uint64_t primary_key()const   { return newname.value;               }
+      uint64_t by_close_time()const { return close_time.elapsed.count(); }
+   };
+   typedef eosio::multi_index< "nameclose"_n, name_close,
+                               indexed_by<"byclosetime"_n, const_mem_fun<name_close, uint64_t, &name_close::by_close_time>  >
+                             > name_close_table;
+
+   // Progress of queueing the auctions opened before `nameclose` existed, which is defined by:
+   // - the `next` name from which the scan of `namebids` resumes
+   // - and `done` set once every such auction has been queued
+   struct [[eosio::table("nameclosemig"), eosio::contract("amax.system")]] name_close_migration {
+      name         next;
+      bool         done = false;
+
+      EOSLIB_SERIALIZE( name_close_migration, (next)(done) )
+   };
+   typedef eosio::singleton< "nameclosemig"_n, name_close_migration > name_close_migration_singleton;
+
    // Defines new global state parameters.
    struct [[eosio::table("global"), eosio::contract("amax.system")]] amax_global_state : eosio::blockchain_parameters {
       uint64_t free_ram()const { return max_ram_size - total_ram_bytes_reserved; }
@@ -155,6 +191,39 @@ namespace eosiosystem {
       )
    };
 
+   // Global state fields updated by ordinary user actions and by `onblock`, kept apart from the large
+   // `amax_global_state` row so that changing them does not rewrite the blockchain parameters:
+   // - `max_ram_size`, `last_ram_increase` ram supply, grown on every ram trade once a ram rate is set,
+   // - `total_ram_bytes_reserved`, `total_ram_stake` ram sold to accounts and the tokens paid for it,
+   // - `last_producer_schedule_update` block time of the last producer election,
+   // - `total_producer_vote_weight` the sum of all producer votes.
+   // Once this singleton exists its values take precedence over the same fields of `global`,
+   // which then only hold the values current at the last write of another global field.
+   struct [[eosio::table("globalhot"), eosio::contract("amax.system")]] amax_global_hot_state {
+      uint64_t             max_ram_size = 0;
+      uint64_t             total_ram_bytes_reserved = 0;
+      int64_t              total_ram_stake = 0;
+      block_timestamp      last_ram_increase;
+      block_timestamp      last_producer_schedule_update;
+      double               total_producer_vote_weight = 0;
+
+      // explicit serialization macro is not necessary, used here only to improve compilation time
+      EOSLIB_SERIALIZE( amax_global_hot_state, (max_ram_size)(total_ram_bytes_reserved)(total_ram_stake)
+                                               (last_ram_increase)(last_producer_schedule_update)
+                                               (total_producer_vote_weight) )
+   };
+
+   // Defines new global state parameters added after version 1.0, defined by:
+   // - `vote_weight_epoch` weeks elapsed since the block timestamp epoch when `vote_weight_multiplier` was cached,
+   // - `vote_weight_multiplier` cached vote weight multiplier, 2 ^ ( vote_weight_epoch / 52 )
+   struct [[eosio::table("global2"), eosio::contract("amax.system")]] amax_global_state2 {
+      uint32_t             vote_weight_epoch       = 0;
+      double               vote_weight_multiplier  = 0;
+
+      // explicit serialization macro is not necessary, used here only to improve compilation time
+      EOSLIB_SERIALIZE( amax_global_state2, (vote_weight_epoch)(vote_weight_multiplier) )
+   };
+
    inline eosio::block_signing_authority convert_to_block_signing_authority( const eosio::public_key& producer_key ) {
       return eosio::block_signing_authority_v0{ .threshold = 1, .keys = {{producer_key, 1}} };
    }
@@ -233,6 +302,28 @@ namespace eosiosystem {
                              > producers_table;
 
    typedef eosio::singleton< "global"_n, amax_global_state >   global_state_singleton;
+   typedef eosio::singleton< "global2"_n, amax_global_state2 > global_state2_singleton;
+   typedef eosio::singleton< "globalhot"_n, amax_global_hot_state > global_hot_state_singleton;
+
+   // Cached outcome of the last producer election, which lets `onblock` skip rescanning the producers
+   // while no vote change can have altered the elected set:
+   // - `producers` the elected producers, sorted by name,
+   // - `min_elected_votes` total votes of the lowest elected producer,
+   // - `max_unelected_votes` upper bound of total votes of the highest active producer not elected,
+   // - `schedule_hash` sha256 of the last proposed producer schedule,
+   // - `dirty` whether the elected set has to be recalculated
+   struct [[eosio::table("electedprods"), eosio::contract("amax.system")]] elected_producers {
+      std::vector<name>    producers;
+      double               min_elected_votes   = 0;
+      double               max_unelected_votes = 0;
+      eosio::checksum256   schedule_hash;
+      bool                 dirty = true;
+
+      // explicit serialization macro is not necessary, used here only to improve compilation time
+      EOSLIB_SERIALIZE( elected_producers, (producers)(min_elected_votes)(max_unelected_votes)(schedule_hash)(dirty) )
+   };
+
+   typedef eosio::singleton< "electedprods"_n, elected_producers > elected_producers_singleton;
 
    struct [[eosio::table, eosio::contract("amax.system")]] user_resources {
       name          owner;
@@ -343,6 +434,24 @@ namespace eosiosystem {
 
    typedef eosio::multi_index< "retbuckets"_n, rex_return_buckets > rex_return_buckets_table;
 
+   // `rex_return_ring` structure underlying the rex return ring table, replaces `rex_return_buckets`:
+   // - `version` defaulted to zero,
+   // - `rates` rate of increase of the 12-hour return bucket starting at `t`, kept at slot
+   //    `( t / bucket_interval ) % total_buckets`, 0 for empty slots
+   struct [[eosio::table,eosio::contract("amax.system")]] rex_return_ring {
+      static constexpr uint32_t bucket_interval = rex_return_pool::hours_per_bucket * seconds_per_hour;
+      static constexpr uint32_t total_buckets   = rex_return_pool::total_intervals * rex_return_pool::dist_interval / bucket_interval;
+
+      uint8_t              version = 0;
+      std::vector<int64_t> rates   = std::vector<int64_t>( total_buckets, 0 );
+
+      static uint32_t slot( const time_point_sec& t ) { return ( t.sec_since_epoch() / bucket_interval ) % total_buckets; }
+
+      uint64_t primary_key()const { return 0; }
+   };
+
+   typedef eosio::multi_index< "retring"_n, rex_return_ring > rex_return_ring_table;
+
    // `rex_fund` structure underlying the rex fund table. A rex fund table entry is defined by:
    // - `version` defaulted to zero,
    // - `owner` the owner of the rex fund,
@@ -357,19 +466,36 @@ namespace eosiosystem {
 
    typedef eosio::multi_index< "rexfund"_n, rex_fund > rex_fund_table;
 
+   // `rex_maturity_buckets` REX maturity state of a version 1 rex balance:
+   // - `next_day` first day, counted in days since epoch, whose bucket has not matured yet,
+   // - `amounts` REX maturing at the start of day `d`, kept at slot `d % num_of_maturity_buckets`,
+   // - `savings` REX in savings, which never matures
+   struct rex_maturity_buckets {
+      static constexpr uint32_t num_of_maturity_buckets = 5;
+
+      uint32_t             next_day = 0;
+      std::vector<int64_t> amounts  = std::vector<int64_t>( num_of_maturity_buckets, 0 );
+      int64_t              savings  = 0;
+
+      EOSLIB_SERIALIZE( rex_maturity_buckets, (next_day)(amounts)(savings) )
+   };
+
    // `rex_balance` structure underlying the rex balance table. A rex balance table entry is defined by:
-   // - `version` defaulted to zero,
+   // - `version` 0 for rows keeping maturities in `rex_maturities`, 1 for rows keeping them in `maturity_buckets`,
    // - `owner` the owner of the rex fund,
    // - `vote_stake` the amount of CORE_SYMBOL currently included in owner's vote,
    // - `rex_balance` the amount of REX owned by owner,
-   // - `matured_rex` matured REX available for selling
+   // - `matured_rex` matured REX available for selling,
+   // - `rex_maturities` version 0 daily maturity buckets, savings kept as a bucket maturing at `time_point_sec::maximum()`,
+   // - `maturity_buckets` version 1 daily maturity buckets and savings
    struct [[eosio::table,eosio::contract("amax.system")]] rex_balance {
       uint8_t version = 0;
       name    owner;
       asset   vote_stake;
       asset   rex_balance;
       int64_t matured_rex = 0;
-      std::deque<std::pair<time_point_sec, int64_t>> rex_maturities; /// REX daily maturity buckets
+      std::deque<std::pair<time_point_sec, int64_t>> rex_maturities; /// REX daily maturity buckets, version 0 only
+      eosio::binary_extension<rex_maturity_buckets> maturity_buckets;
 
       uint64_t primary_key()const { return owner.value; }
    };
@@ -428,6 +554,50 @@ namespace eosiosystem {
    typedef eosio::multi_index< "rexqueue"_n, rex_order,
                                indexed_by<"bytime"_n, const_mem_fun<rex_order, uint64_t, &rex_order::by_time>>> rex_order_table;
 
+   // sellrex orders filled by `runrex` are moved out of `rexqueue` into this table, where they are
+   // kept closed until their proceeds are collected by the owner's next REX action
+   typedef eosio::multi_index< "rexfilled"_n, rex_order > rex_filled_order_table;
+
+   // REX maintenance state and metrics, updated by every `runrex` pass:
+   // - `budget` number of items of each category processed by the next opportunistic pass,
+   //    doubled while backlog is left behind and halved once it is drained, by adaptive passes only,
+   // - `order_cursor` `bytime` key of the sellrex order the next pass resumes from, 0 to start from the oldest,
+   // - `cpu_loan_backlog`, `net_loan_backlog`, `order_backlog` items still due after the last pass, counted up to `budget`,
+   // - `processed` total number of loans and orders processed so far,
+   // - `last_run` time of the last pass.
+   struct [[eosio::table,eosio::contract("amax.system")]] rex_maintenance {
+      uint8_t          version          = 0;
+      uint16_t         budget           = rex_maintenance_min_budget;
+      uint64_t         order_cursor     = 0;
+      uint32_t         cpu_loan_backlog = 0;
+      uint32_t         net_loan_backlog = 0;
+      uint32_t         order_backlog    = 0;
+      uint64_t         processed        = 0;
+      time_point_sec   last_run;
+
+      EOSLIB_SERIALIZE( rex_maintenance, (version)(budget)(order_cursor)(cpu_loan_backlog)(net_loan_backlog)
+                                         (order_backlog)(processed)(last_run) )
+   };
+
+   typedef eosio::singleton<"rexmaint"_n, rex_maintenance> rex_maintenance_singleton;
+
+   // `delegatebatch` entry, stakes `stake_net_quantity` and `stake_cpu_quantity` for the benefit of `receiver`
+   struct delegate_stake {
+      name     receiver;
+      asset    stake_net_quantity;
+      asset    stake_cpu_quantity;
+
+      EOSLIB_SERIALIZE( delegate_stake, (receiver)(stake_net_quantity)(stake_cpu_quantity) )
+   };
+
+   // `buyrambatch` entry, `bytes` of ram bought for `receiver`
+   struct ram_purchase {
+      name     receiver;
+      uint32_t bytes = 0;
+
+      EOSLIB_SERIALIZE( ram_purchase, (receiver)(bytes) )
+   };
+
    struct rex_order_outcome {
       bool success;
       asset proceeds;
@@ -519,6 +689,14 @@ namespace eosiosystem {
       time_point_sec utilization_timestamp   = {};                 // When adjusted_utilization was last updated
    };
 
+   struct powerup_queue_state {
+      uint16_t       batch     = powerup_queue_min_batch; // Number of expired orders released by the next adaptive pass,
+                                                          //    doubled while backlog is left behind and halved once it is drained,
+                                                          //    by adaptive passes only.
+      uint32_t       backlog   = 0;                       // Expired orders still queued after the last pass, counted up to `batch`.
+      uint64_t       processed = 0;                       // Total number of expired orders released so far.
+   };
+
    struct [[eosio::table("powup.state"),eosio::contract("amax.system")]] powerup_state {
       static constexpr uint32_t default_powerup_days = 30; // 30 day resource powerups
 
@@ -527,12 +705,36 @@ namespace eosiosystem {
       powerup_state_resource     cpu               = {};                     // CPU market state
       uint32_t                   powerup_days      = default_powerup_days;   // `powerup` `days` argument must match this.
       asset                      min_powerup_fee   = {};                     // fees below this amount are rejected
+      eosio::binary_extension<powerup_queue_state> queue;                    // order queue processing state, set by the first pass
 
       uint64_t primary_key()const { return 0; }
    };
 
    typedef eosio::singleton<"powup.state"_n, powerup_state> powerup_state_singleton;
 
+   // Price curve of a powerup market resource, precomputed by `cfgpowerup` at the utilization fractions
+   // u = i / powerup_curve_segments and interpolated linearly in between:
+   // - `integral` u ^ exponent / exponent, scaled by powerup_frac,
+   // - `price` u ^ (exponent - 1), scaled by powerup_frac.
+   // When the curve's second derivative is bounded by K, an interpolated value is within K / (8 * segments ^ 2)
+   // of the exact one, so for an exponent of 1, 2 or >= 3 a fee is within
+   // (max_price - min_price) * exponent * (exponent - 1) / (8 * segments ^ 2) + 1 of the exact integral.
+   // Other exponents have no such bound near u = 0, their curve is left empty and their fee is computed in floating point.
+   struct powerup_price_curve {
+      std::vector<int64_t> integral;
+      std::vector<int64_t> price;
+   };
+
+   struct [[eosio::table("powup.curve"),eosio::contract("amax.system")]] powerup_curves {
+      uint8_t              version = 0;
+      powerup_price_curve  net     = {};   // NET market price curve
+      powerup_price_curve  cpu     = {};   // CPU market price curve
+
+      uint64_t primary_key()const { return 0; }
+   };
+
+   typedef eosio::singleton<"powup.curve"_n, powerup_curves> powerup_curves_singleton;
+
    struct [[eosio::table("powup.order"),eosio::contract("amax.system")]] powerup_order {
       uint8_t              version = 0;
       uint64_t             id;
@@ -572,14 +774,33 @@ namespace eosiosystem {
          producers_table          _producers;
          global_state_singleton   _global;
          amax_global_state       _gstate;
+         global_state2_singleton  _global2;
+         // read on first use by stake2vote, most actions never need it
+         std::optional<amax_global_state2> _gstate2;
+         global_hot_state_singleton _globalhot;
+         // the fields of `amax_global_hot_state` in `_gstate` are only current after load_hot_state()
+         bool                     _gstate_hot_loaded = false;
+         // set on any change of `_gstate`, which the destructor writes back only when set:
+         // `_gstate_hot_dirty` for the fields of `amax_global_hot_state`, `_gstate_dirty` for all others
+         bool                     _gstate_dirty = false;
+         bool                     _gstate_hot_dirty = false;
          rammarket                _rammarket;
          rex_pool_table           _rexpool;
          rex_return_pool_table    _rexretpool;
-         rex_return_buckets_table _rexretbuckets;
+         rex_return_ring_table    _rexretring;
          rex_fund_table           _rexfunds;
          rex_balance_table        _rexbalance;
          rex_order_table          _rexorders;
 
+         // resource limits read or written during the current action, written back once by the destructor
+         struct account_limits {
+            int64_t ram_bytes = 0;
+            int64_t net       = 0;
+            int64_t cpu       = 0;
+            bool    dirty     = false;
+         };
+         std::map<name, account_limits> _account_limits;
+
       public:
          static constexpr eosio::name active_permission{"active"_n};
          static constexpr eosio::name token_account{"amax.token"_n};
@@ -693,6 +914,19 @@ namespace eosiosystem {
          void delegatebw( const name& from, const name& receiver,
                           const asset& stake_net_quantity, const asset& stake_cpu_quantity, bool transfer );
 
+         /**
+          * Delegate batch action. Stakes SYS from the balance of `from` for the benefit of many receivers
+          * at once, with a single token transfer to the stake account and a single vote update of `from`.
+          *
+          * @param from - the account holding tokens to be staked,
+          * @param stakes - receivers and their NET/CPU stakes, at most `max_delegate_batch_size` entries,
+          *    `from` itself is not allowed as a receiver.
+          *
+          * @post All producers `from` account has voted for will have their votes updated immediately.
+          */
+         [[eosio::action]]
+         void delegatebatch( const name& from, const std::vector<delegate_stake>& stakes );
+
          /**
           * Setrex action, sets total_rent balance of REX pool to the passed value.
           * @param balance - amount to set the REX pool balance.
@@ -880,7 +1114,8 @@ namespace eosiosystem {
           * Action does not execute anything related to a specific user.
           *
           * @param user - any account can execute this action,
-          * @param max - number of each of CPU loans, NET loans, and sell orders to be processed.
+          * @param max - number of each of CPU loans, NET loans, and sell orders to be processed,
+          *    0 to use the adaptive maintenance budget.
           */
          [[eosio::action]]
          void rexexec( const name& user, uint16_t max );
@@ -984,6 +1219,18 @@ namespace eosiosystem {
          [[eosio::action]]
          void buyrambytes( const name& payer, const name& receiver, uint32_t bytes );
 
+         /**
+          * Buy ram bytes for many receivers action. The aggregate purchase is priced once against the
+          * ram market and paid with a single fee transfer and a single transfer to `amax.ram`.
+          * Each receiver is credited the bytes requested for it, the last one also absorbs the
+          * rounding difference of the aggregate conversion.
+          *
+          * @param payer - the ram buyer,
+          * @param purchases - receivers and bytes to buy for them, at most `max_ram_batch_size` entries.
+          */
+         [[eosio::action]]
+         void buyrambatch( const name& payer, const std::vector<ram_purchase>& purchases );
+
          /**
           * Sell ram action, reduces quota by bytes and then performs an inline transfer of tokens
           * to receiver based upon the average purchase price of the original quota.
@@ -1166,6 +1413,9 @@ namespace eosiosystem {
 
          /**
           * Bid refund action, allows the account `bidder` to get back the amount it bid so far on a `newname` name.
+          * Outbid amounts are not refunded automatically, they accrue until claimed with this action
+          * or spent on a new bid of `bidder` on `newname`. Any account may push the refund, which is always
+          * paid to `bidder`, so that the account paying for the refund row can release its RAM.
           *
           * @param bidder - the account that gets refunded,
           * @param newname - the name for which the bid was placed and now it gets refunded for.
@@ -1194,7 +1444,7 @@ namespace eosiosystem {
           * Process power queue and update state. Action does not execute anything related to a specific user.
           *
           * @param user - any account can execute this action
-          * @param max - number of queue items to process
+          * @param max - number of queue items to process, 0 to use the adaptive batch size kept in `powerup_state`
           */
          [[eosio::action]]
          void powerupexec( const name& user, uint16_t max );
@@ -1219,6 +1469,7 @@ namespace eosiosystem {
          using setacctcpu_action = eosio::action_wrapper<"setacctcpu"_n, &system_contract::setacctcpu>;
          using activate_action = eosio::action_wrapper<"activate"_n, &system_contract::activate>;
          using delegatebw_action = eosio::action_wrapper<"delegatebw"_n, &system_contract::delegatebw>;
+         using delegatebatch_action = eosio::action_wrapper<"delegatebatch"_n, &system_contract::delegatebatch>;
          using deposit_action = eosio::action_wrapper<"deposit"_n, &system_contract::deposit>;
          using withdraw_action = eosio::action_wrapper<"withdraw"_n, &system_contract::withdraw>;
          using buyrex_action = eosio::action_wrapper<"buyrex"_n, &system_contract::buyrex>;
@@ -1241,6 +1492,7 @@ namespace eosiosystem {
          using undelegatebw_action = eosio::action_wrapper<"undelegatebw"_n, &system_contract::undelegatebw>;
          using buyram_action = eosio::action_wrapper<"buyram"_n, &system_contract::buyram>;
          using buyrambytes_action = eosio::action_wrapper<"buyrambytes"_n, &system_contract::buyrambytes>;
+         using buyrambatch_action = eosio::action_wrapper<"buyrambatch"_n, &system_contract::buyrambatch>;
          using sellram_action = eosio::action_wrapper<"sellram"_n, &system_contract::sellram>;
          using refund_action = eosio::action_wrapper<"refund"_n, &system_contract::refund>;
          using regproducer_action = eosio::action_wrapper<"regproducer"_n, &system_contract::regproducer>;
@@ -1269,10 +1521,11 @@ namespace eosiosystem {
 
          const symbol& core_symbol() const;
 
+         void load_hot_state();
          void update_ram_supply();
 
          // defined in rex.cpp
-         void runrex( uint16_t max );
+         void runrex( uint16_t max = 0 );
          void update_rex_pool();
          void update_resource_limits( const name& from, const name& receiver, int64_t delta_net, int64_t delta_cpu );
          void check_voting_requirement( const name& owner,
@@ -1301,23 +1554,46 @@ namespace eosiosystem {
                                        const asset& rex_in_sell_order );
          int64_t read_rex_savings( const rex_balance_table::const_iterator& bitr );
          void put_rex_savings( const rex_balance_table::const_iterator& bitr, int64_t rex );
+         static void migrate_rex_maturities( rex_balance& rb );
+         static void mature_rex_buckets( rex_balance& rb );
+         static void add_to_rex_maturity( rex_balance& rb, int64_t rex );
          void update_rex_stake( const name& voter );
 
+         rex_return_ring_table::const_iterator migrate_rex_return_buckets();
          void add_loan_to_rex_pool( const asset& payment, int64_t rented_tokens, bool new_loan );
-         void remove_loan_from_rex_pool( const rex_loan& loan );
+         void add_loan_to_rex_pool( rex_pool& pool, const asset& payment, int64_t rented_tokens, bool new_loan );
+         void remove_loan_from_rex_pool( rex_pool& pool, const rex_loan& loan );
          template <typename Index, typename Iterator>
          int64_t update_renewed_loan( Index& idx, const Iterator& itr, int64_t rented_tokens );
 
          // defined in delegate_bandwidth.cpp
          void changebw( name from, const name& receiver,
                         const asset& stake_net_quantity, const asset& stake_cpu_quantity, bool transfer );
+         int64_t purchase_ram( const name& payer, const asset& quant );
+         void add_ram( const name& receiver, int64_t bytes );
+         void update_delegation( const name& from, const name& receiver,
+                                 const asset& stake_net_delta, const asset& stake_cpu_delta );
          void update_voting_power( const name& voter, const asset& total_update );
+         void get_account_limits( const name& account, int64_t& ram_bytes, int64_t& net, int64_t& cpu );
+         void set_account_limits( const name& account, int64_t ram_bytes, int64_t net, int64_t cpu );
+         void flush_account_limits();
+
+         // defined in name_bidding.cpp
+         void close_name_auctions( const block_timestamp& timestamp );
 
          // defined in voting.cpp
          void register_producer( const name& producer, const eosio::block_signing_authority& producer_authority, const std::string& url, uint16_t location );
          void update_elected_producers( const block_timestamp& timestamp );
+         bool check_elected_boundary( elected_producers& elected, const producer_info& prod )const;
+         void invalidate_elected_producers();
+         // producer => (vote delta, whether the producer is in the newly voted set)
+         using producer_deltas_t = std::map<name, std::pair<double, bool>>;
+
          void update_votes( const name& voter, const name& proxy, const std::vector<name>& producers, bool voting );
          void propagate_weight_change( const voter_info& voter );
+         double stake2vote( int64_t staked );
+         void propagate_weight_change( const voter_info& voter, producer_deltas_t& producer_deltas );
+         void apply_producer_deltas( const producer_deltas_t& producer_deltas, bool voting );
 
          template <auto system_contract::*...Ptrs>
          class registration {
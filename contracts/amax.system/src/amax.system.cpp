@@ -16,15 +16,41 @@ namespace eosiosystem {
     _voters(get_self(), get_self().value),
     _producers(get_self(), get_self().value),
     _global(get_self(), get_self().value),
+    _global2(get_self(), get_self().value),
+    _globalhot(get_self(), get_self().value),
     _rammarket(get_self(), get_self().value),
     _rexpool(get_self(), get_self().value),
     _rexretpool(get_self(), get_self().value),
-    _rexretbuckets(get_self(), get_self().value),
+    _rexretring(get_self(), get_self().value),
     _rexfunds(get_self(), get_self().value),
     _rexbalance(get_self(), get_self().value),
     _rexorders(get_self(), get_self().value)
    {
-      _gstate  = _global.exists() ? _global.get() : get_default_parameters();
+      if ( _global.exists() ) {
+         _gstate = _global.get();
+      } else {
+         _gstate = get_default_parameters();
+         _gstate_dirty = true;
+      }
+   }
+
+   /**
+    * Overlays the fields kept in `globalhot` onto `_gstate`, on first use only: actions that
+    * neither read nor change them don't pay for the extra row read
+    */
+   void system_contract::load_hot_state() {
+      if ( _gstate_hot_loaded ) return;
+
+      _gstate_hot_loaded = true;
+      if ( _globalhot.exists() ) {
+         const auto hot = _globalhot.get();
+         _gstate.max_ram_size                  = hot.max_ram_size;
+         _gstate.total_ram_bytes_reserved      = hot.total_ram_bytes_reserved;
+         _gstate.total_ram_stake               = hot.total_ram_stake;
+         _gstate.last_ram_increase             = hot.last_ram_increase;
+         _gstate.last_producer_schedule_update = hot.last_producer_schedule_update;
+         _gstate.total_producer_vote_weight    = hot.total_producer_vote_weight;
+      }
    }
 
    symbol system_contract::get_core_symbol(const name& self) {
@@ -47,11 +73,26 @@ namespace eosiosystem {
    }
 
    system_contract::~system_contract() {
-      _global.set( _gstate, get_self() );
+      flush_account_limits();
+      // hot fields of the full row may be stale, `globalhot` overrides them whenever it exists
+      if ( _gstate_dirty ) {
+         _global.set( _gstate, get_self() );
+      }
+      if ( _gstate_hot_dirty ) {
+         _globalhot.set( amax_global_hot_state{
+            .max_ram_size                  = _gstate.max_ram_size,
+            .total_ram_bytes_reserved      = _gstate.total_ram_bytes_reserved,
+            .total_ram_stake               = _gstate.total_ram_stake,
+            .last_ram_increase             = _gstate.last_ram_increase,
+            .last_producer_schedule_update = _gstate.last_producer_schedule_update,
+            .total_producer_vote_weight    = _gstate.total_producer_vote_weight
+         }, get_self() );
+      }
    }
 
    void system_contract::setram( uint64_t max_ram_size ) {
       require_auth( get_self() );
+      load_hot_state();
 
       check( _gstate.max_ram_size < max_ram_size, "ram may only be increased" ); /// decreasing ram might result market maker issues
       check( max_ram_size < 1024ll*1024*1024*1024*1024, "ram size is unrealistic" );
@@ -68,9 +109,11 @@ namespace eosiosystem {
       });
 
       _gstate.max_ram_size = max_ram_size;
+      _gstate_hot_dirty = true;
    }
 
    void system_contract::update_ram_supply() {
+      load_hot_state();
       auto cbt = eosio::current_block_time();
 
       if( cbt <= _gstate.last_ram_increase ) return;
@@ -86,6 +129,7 @@ namespace eosiosystem {
          m.base.balance.amount += new_ram;
       });
       _gstate.last_ram_increase = cbt;
+      _gstate_hot_dirty = true;
    }
 
    void system_contract::setramrate( uint16_t bytes_per_block ) {
@@ -93,11 +137,13 @@ namespace eosiosystem {
 
       update_ram_supply();
       _gstate.new_ram_per_block = bytes_per_block;
+      _gstate_dirty = true;
    }
 
    void system_contract::setparams( const eosio::blockchain_parameters& params ) {
       require_auth( get_self() );
       (eosio::blockchain_parameters&)(_gstate) = params;
+      _gstate_dirty = true;
       check( 3 <= _gstate.max_authority_depth, "max_authority_depth should be at least 3" );
       set_blockchain_parameters( params );
    }
@@ -265,6 +311,7 @@ namespace eosiosystem {
       _producers.modify( prod, same_payer, [&](auto& p) {
             p.deactivate();
          });
+      invalidate_elected_producers();
    }
 
    void system_contract::updtrevision( uint8_t revision ) {
@@ -274,6 +321,7 @@ namespace eosiosystem {
       check( revision <= 1, // set upper bound to greatest revision supported in the code
              "specified revision is not yet supported by the code" );
       _gstate.revision = revision;
+      _gstate_dirty = true;
    }
 
    void system_contract::setinflation(  time_point inflation_start_time, const asset& initial_inflation_per_block ) {
@@ -288,6 +336,7 @@ namespace eosiosystem {
 
       _gstate.inflation_start_time = inflation_start_time;
       _gstate.initial_inflation_per_block = initial_inflation_per_block;
+      _gstate_dirty = true;
    }
 
    /**
@@ -367,6 +416,7 @@ namespace eosiosystem {
       check( system_token_supply.amount > 0, "system token supply must be greater than 0" );
       
       _gstate.core_symbol = core;
+      _gstate_dirty = true;
 
       _rammarket.emplace( get_self(), [&]( auto& m ) {
          m.supply.amount = 100000000000000ll;
@@ -45,6 +45,43 @@ namespace eosiosystem {
       require_auth( payer );
       update_ram_supply();
 
+      const int64_t bytes_out = purchase_ram( payer, quant );
+      add_ram( receiver, bytes_out );
+   }
+
+   void system_contract::buyrambatch( const name& payer, const std::vector<ram_purchase>& purchases )
+   {
+      require_auth( payer );
+      check( purchases.size() > 0, "purchases must not be empty" );
+      check( purchases.size() <= max_ram_batch_size, "too many purchases in one batch" );
+      update_ram_supply();
+
+      int64_t total_bytes = 0;
+      for( const auto& p : purchases ) {
+         check( p.bytes > 0, "must reserve a positive amount" );
+         total_bytes += p.bytes;
+      }
+
+      const auto& market          = _rammarket.get( ramcore_symbol.raw(), "ram market does not exist" );
+      const int64_t cost          = exchange_state::get_bancor_input( market.base.balance.amount, market.quote.balance.amount, total_bytes );
+      const int64_t cost_plus_fee = cost / double(0.995);
+      const int64_t bytes_out     = purchase_ram( payer, asset{ cost_plus_fee, core_symbol() } );
+
+      // the aggregate conversion may round a byte or so away from the requested total
+      const int64_t last_bytes = purchases.back().bytes + ( bytes_out - total_bytes );
+      check( last_bytes > 0, "must reserve a positive amount" );
+      for( size_t i = 0; i + 1 < purchases.size(); ++i ) {
+         add_ram( purchases[i].receiver, purchases[i].bytes );
+      }
+      add_ram( purchases.back().receiver, last_bytes );
+   }
+
+   /**
+    *  Converts `quant` of `payer` into ram at the current market price, pays the fee and
+    *  returns the bytes bought. The bytes are not credited to any account yet.
+    */
+   int64_t system_contract::purchase_ram( const name& payer, const asset& quant )
+   {
       check( quant.symbol == core_symbol(), "must buy ram with core token" );
       check( quant.amount > 0, "must purchase a positive amount" );
 
@@ -78,7 +115,13 @@ namespace eosiosystem {
 
       _gstate.total_ram_bytes_reserved += uint64_t(bytes_out);
       _gstate.total_ram_stake          += quant_after_fee.amount;
+      _gstate_hot_dirty = true;
+
+      return bytes_out;
+   }
 
+   void system_contract::add_ram( const name& receiver, int64_t bytes )
+   {
       user_resources_table  userres( get_self(), receiver.value );
       auto res_itr = userres.find( receiver.value );
       if( res_itr ==  userres.end() ) {
@@ -86,19 +129,19 @@ namespace eosiosystem {
                res.owner = receiver;
                res.net_weight = asset( 0, core_symbol() );
                res.cpu_weight = asset( 0, core_symbol() );
-               res.ram_bytes = bytes_out;
+               res.ram_bytes = bytes;
             });
       } else {
          userres.modify( res_itr, receiver, [&]( auto& res ) {
-               res.ram_bytes += bytes_out;
+               res.ram_bytes += bytes;
             });
       }
 
       auto voter_itr = _voters.find( res_itr->owner.value );
       if( voter_itr == _voters.end() || !has_field( voter_itr->flags1, voter_info::flags1_fields::ram_managed ) ) {
          int64_t ram_bytes, net, cpu;
-         get_resource_limits( res_itr->owner, ram_bytes, net, cpu );
-         set_resource_limits( res_itr->owner, res_itr->ram_bytes + ram_gift_bytes, net, cpu );
+         get_account_limits( res_itr->owner, ram_bytes, net, cpu );
+         set_account_limits( res_itr->owner, res_itr->ram_bytes + ram_gift_bytes, net, cpu );
       }
    }
 
@@ -132,6 +175,7 @@ namespace eosiosystem {
 
       _gstate.total_ram_bytes_reserved -= static_cast<decltype(_gstate.total_ram_bytes_reserved)>(bytes); // bytes > 0 is asserted above
       _gstate.total_ram_stake          -= tokens_out.amount;
+      _gstate_hot_dirty = true;
 
       //// this shouldn't happen, but just in case it does we should prevent it
       check( _gstate.total_ram_stake >= 0, "error, attempt to unstake more tokens than previously staked" );
@@ -143,8 +187,8 @@ namespace eosiosystem {
       auto voter_itr = _voters.find( res_itr->owner.value );
       if( voter_itr == _voters.end() || !has_field( voter_itr->flags1, voter_info::flags1_fields::ram_managed ) ) {
          int64_t ram_bytes, net, cpu;
-         get_resource_limits( res_itr->owner, ram_bytes, net, cpu );
-         set_resource_limits( res_itr->owner, res_itr->ram_bytes + ram_gift_bytes, net, cpu );
+         get_account_limits( res_itr->owner, ram_bytes, net, cpu );
+         set_account_limits( res_itr->owner, res_itr->ram_bytes + ram_gift_bytes, net, cpu );
       }
 
       {
@@ -175,77 +219,7 @@ namespace eosiosystem {
          from = receiver;
       }
 
-      // update stake delegated from "from" to "receiver"
-      {
-         del_bandwidth_table     del_tbl( get_self(), from.value );
-         auto itr = del_tbl.find( receiver.value );
-         if( itr == del_tbl.end() ) {
-            itr = del_tbl.emplace( from, [&]( auto& dbo ){
-                  dbo.from          = from;
-                  dbo.to            = receiver;
-                  dbo.net_weight    = stake_net_delta;
-                  dbo.cpu_weight    = stake_cpu_delta;
-               });
-         }
-         else {
-            del_tbl.modify( itr, same_payer, [&]( auto& dbo ){
-                  dbo.net_weight    += stake_net_delta;
-                  dbo.cpu_weight    += stake_cpu_delta;
-               });
-         }
-         check( 0 <= itr->net_weight.amount, "insufficient staked net bandwidth" );
-         check( 0 <= itr->cpu_weight.amount, "insufficient staked cpu bandwidth" );
-         if ( itr->is_empty() ) {
-            del_tbl.erase( itr );
-         }
-      } // itr can be invalid, should go out of scope
-
-      // update totals of "receiver"
-      {
-         user_resources_table   totals_tbl( get_self(), receiver.value );
-         auto tot_itr = totals_tbl.find( receiver.value );
-         if( tot_itr ==  totals_tbl.end() ) {
-            tot_itr = totals_tbl.emplace( from, [&]( auto& tot ) {
-                  tot.owner = receiver;
-                  tot.net_weight    = stake_net_delta;
-                  tot.cpu_weight    = stake_cpu_delta;
-               });
-         } else {
-            totals_tbl.modify( tot_itr, from == receiver ? from : same_payer, [&]( auto& tot ) {
-                  tot.net_weight    += stake_net_delta;
-                  tot.cpu_weight    += stake_cpu_delta;
-               });
-         }
-         check( 0 <= tot_itr->net_weight.amount, "insufficient staked total net bandwidth" );
-         check( 0 <= tot_itr->cpu_weight.amount, "insufficient staked total cpu bandwidth" );
-
-         {
-            bool ram_managed = false;
-            bool net_managed = false;
-            bool cpu_managed = false;
-
-            auto voter_itr = _voters.find( receiver.value );
-            if( voter_itr != _voters.end() ) {
-               ram_managed = has_field( voter_itr->flags1, voter_info::flags1_fields::ram_managed );
-               net_managed = has_field( voter_itr->flags1, voter_info::flags1_fields::net_managed );
-               cpu_managed = has_field( voter_itr->flags1, voter_info::flags1_fields::cpu_managed );
-            }
-
-            if( !(net_managed && cpu_managed) ) {
-               int64_t ram_bytes, net, cpu;
-               get_resource_limits( receiver, ram_bytes, net, cpu );
-
-               set_resource_limits( receiver,
-                                    ram_managed ? ram_bytes : std::max( tot_itr->ram_bytes + ram_gift_bytes, ram_bytes ),
-                                    net_managed ? net : tot_itr->net_weight.amount,
-                                    cpu_managed ? cpu : tot_itr->cpu_weight.amount );
-            }
-         }
-
-         if ( tot_itr->is_empty() ) {
-            totals_tbl.erase( tot_itr );
-         }
-      } // tot_itr can be invalid, should go out of scope
+      update_delegation( from, receiver, stake_net_delta, stake_cpu_delta );
 
       // create refund or update from existing refund
       if ( stake_account != source_stake_from ) { //for eosio both transfer and refund make no sense
@@ -339,6 +313,120 @@ namespace eosiosystem {
       update_voting_power( from, stake_net_delta + stake_cpu_delta );
    }
 
+   void system_contract::update_delegation( const name& from, const name& receiver,
+                                            const asset& stake_net_delta, const asset& stake_cpu_delta )
+   {
+      // update stake delegated from "from" to "receiver"
+      {
+         del_bandwidth_table     del_tbl( get_self(), from.value );
+         auto itr = del_tbl.find( receiver.value );
+         if( itr == del_tbl.end() ) {
+            itr = del_tbl.emplace( from, [&]( auto& dbo ){
+                  dbo.from          = from;
+                  dbo.to            = receiver;
+                  dbo.net_weight    = stake_net_delta;
+                  dbo.cpu_weight    = stake_cpu_delta;
+               });
+         }
+         else {
+            del_tbl.modify( itr, same_payer, [&]( auto& dbo ){
+                  dbo.net_weight    += stake_net_delta;
+                  dbo.cpu_weight    += stake_cpu_delta;
+               });
+         }
+         check( 0 <= itr->net_weight.amount, "insufficient staked net bandwidth" );
+         check( 0 <= itr->cpu_weight.amount, "insufficient staked cpu bandwidth" );
+         if ( itr->is_empty() ) {
+            del_tbl.erase( itr );
+         }
+      } // itr can be invalid, should go out of scope
+
+      // update totals of "receiver"
+      {
+         user_resources_table   totals_tbl( get_self(), receiver.value );
+         auto tot_itr = totals_tbl.find( receiver.value );
+         if( tot_itr ==  totals_tbl.end() ) {
+            tot_itr = totals_tbl.emplace( from, [&]( auto& tot ) {
+                  tot.owner = receiver;
+                  tot.net_weight    = stake_net_delta;
+                  tot.cpu_weight    = stake_cpu_delta;
+               });
+         } else {
+            totals_tbl.modify( tot_itr, from == receiver ? from : same_payer, [&]( auto& tot ) {
+                  tot.net_weight    += stake_net_delta;
+                  tot.cpu_weight    += stake_cpu_delta;
+               });
+         }
+         check( 0 <= tot_itr->net_weight.amount, "insufficient staked total net bandwidth" );
+         check( 0 <= tot_itr->cpu_weight.amount, "insufficient staked total cpu bandwidth" );
+
+         {
+            bool ram_managed = false;
+            bool net_managed = false;
+            bool cpu_managed = false;
+
+            auto voter_itr = _voters.find( receiver.value );
+            if( voter_itr != _voters.end() ) {
+               ram_managed = has_field( voter_itr->flags1, voter_info::flags1_fields::ram_managed );
+               net_managed = has_field( voter_itr->flags1, voter_info::flags1_fields::net_managed );
+               cpu_managed = has_field( voter_itr->flags1, voter_info::flags1_fields::cpu_managed );
+            }
+
+            if( !(net_managed && cpu_managed) ) {
+               int64_t ram_bytes, net, cpu;
+               get_account_limits( receiver, ram_bytes, net, cpu );
+
+               set_account_limits( receiver,
+                                    ram_managed ? ram_bytes : std::max( tot_itr->ram_bytes + ram_gift_bytes, ram_bytes ),
+                                    net_managed ? net : tot_itr->net_weight.amount,
+                                    cpu_managed ? cpu : tot_itr->cpu_weight.amount );
+            }
+         }
+
+         if ( tot_itr->is_empty() ) {
+            totals_tbl.erase( tot_itr );
+         }
+      } // tot_itr can be invalid, should go out of scope
+   }
+
+   void system_contract::get_account_limits( const name& account, int64_t& ram_bytes, int64_t& net, int64_t& cpu )
+   {
+      auto itr = _account_limits.find( account );
+      if( itr == _account_limits.end() ) {
+         account_limits limits;
+         get_resource_limits( account, limits.ram_bytes, limits.net, limits.cpu );
+         itr = _account_limits.emplace( account, limits ).first;
+      }
+      ram_bytes = itr->second.ram_bytes;
+      net       = itr->second.net;
+      cpu       = itr->second.cpu;
+   }
+
+   void system_contract::set_account_limits( const name& account, int64_t ram_bytes, int64_t net, int64_t cpu )
+   {
+      int64_t cur_ram_bytes, cur_net, cur_cpu;
+      get_account_limits( account, cur_ram_bytes, cur_net, cur_cpu );
+      if( cur_ram_bytes == ram_bytes && cur_net == net && cur_cpu == cpu ) {
+         return; // no-op, keep the host state untouched
+      }
+
+      auto& limits = _account_limits[account];
+      limits.ram_bytes = ram_bytes;
+      limits.net       = net;
+      limits.cpu       = cpu;
+      limits.dirty     = true;
+   }
+
+   void system_contract::flush_account_limits()
+   {
+      for( const auto& [account, limits] : _account_limits ) {
+         if( limits.dirty ) {
+            set_resource_limits( account, limits.ram_bytes, limits.net, limits.cpu );
+         }
+      }
+      _account_limits.clear();
+   }
+
    void system_contract::update_voting_power( const name& voter, const asset& total_update )
    {
       auto voter_itr = _voters.find( voter.value );
@@ -373,6 +461,33 @@ namespace eosiosystem {
       changebw( from, receiver, stake_net_quantity, stake_cpu_quantity, transfer);
    } // delegatebw
 
+   void system_contract::delegatebatch( const name& from, const std::vector<delegate_stake>& stakes )
+   {
+      require_auth( from );
+      check( stakes.size() > 0, "stakes must not be empty" );
+      check( stakes.size() <= max_delegate_batch_size, "too many stakes in one batch" );
+
+      asset zero_asset( 0, core_symbol() );
+      asset total_stake = zero_asset;
+      for( const auto& s : stakes ) {
+         check( s.receiver != from, "use delegatebw to stake to self" );
+         check( s.stake_cpu_quantity >= zero_asset, "must stake a positive amount" );
+         check( s.stake_net_quantity >= zero_asset, "must stake a positive amount" );
+         check( s.stake_net_quantity.amount + s.stake_cpu_quantity.amount > 0, "must stake a positive amount" );
+
+         update_delegation( from, s.receiver, s.stake_net_quantity, s.stake_cpu_quantity );
+         total_stake += s.stake_net_quantity + s.stake_cpu_quantity;
+      }
+
+      if ( stake_account != from ) {
+         token::transfer_action transfer_act{ token_account, { {from, active_permission} } };
+         transfer_act.send( from, stake_account, total_stake, "stake bandwidth" );
+      }
+
+      vote_stake_updater( from );
+      update_voting_power( from, total_stake );
+   } // delegatebatch
+
    void system_contract::undelegatebw( const name& from, const name& receiver,
                                        const asset& unstake_net_quantity, const asset& unstake_cpu_quantity )
    {
@@ -8,6 +8,25 @@ namespace eosiosystem {
 
    using eosio::check;
 
+   // integers up to 2^53 are exactly representable as doubles
+   static constexpr uint64_t exact_double_limit = uint64_t(1) << 53;
+
+   /**
+    * Computes `floor( a * b / d )` in integers when the result is bit-identical to
+    * `int64_t( (double(a) * b) / d )`, i.e. when `a * b + d <= 2^53`: the product and
+    * the divisor are then exact doubles, and the rounded quotient cannot reach the next integer.
+    *
+    * @return false if the operands are outside of the exact range, the caller keeps the double path.
+    */
+   static bool exact_mul_div( int64_t a, int64_t b, int64_t d, int64_t& out )
+   {
+      if ( a < 0 || b < 0 || d <= 0 || uint64_t(d) > exact_double_limit ) return false;
+      const uint128_t p = uint128_t(a) * uint64_t(b);
+      if ( p + uint64_t(d) > exact_double_limit ) return false;
+      out = int64_t( uint64_t(p) / uint64_t(d) );
+      return true;
+   }
+
    asset exchange_state::convert_to_exchange( connector& reserve, const asset& payment )
    {
       const double S0 = supply.amount;
@@ -82,11 +101,16 @@ namespace eosiosystem {
                                               int64_t out_reserve,
                                               int64_t inp )
    {
+      int64_t out = 0;
+      if ( exact_mul_div( inp, out_reserve, inp_reserve + inp, out ) ) {
+         return out;
+      }
+
       const double ib = inp_reserve;
       const double ob = out_reserve;
       const double in = inp;
 
-      int64_t out = int64_t( (in * ob) / (ib + in) );
+      out = int64_t( (in * ob) / (ib + in) );
 
       if ( out < 0 ) out = 0;
 
@@ -97,10 +121,15 @@ namespace eosiosystem {
                                              int64_t inp_reserve,
                                              int64_t out )
    {
+      int64_t inp = 0;
+      if ( exact_mul_div( out, inp_reserve, out_reserve - out, inp ) ) {
+         return inp;
+      }
+
       const double ob = out_reserve;
       const double ib = inp_reserve;
 
-      int64_t inp = (ib * out) / (ob - out);
+      inp = (ib * out) / (ob - out);
 
       if ( inp < 0 ) inp = 0;
 
@@ -1,11 +1,10 @@
 #include <amax.system/amax.system.hpp>
 #include <amax.token/amax.token.hpp>
 
-#include <eosio/transaction.hpp>
-
 namespace eosiosystem {
 
    using eosio::current_time_point;
+   using eosio::microseconds;
    using eosio::token;
 
    void system_contract::bidname( const name& bidder, const name& newname, const asset& bid ) {
@@ -18,8 +17,26 @@ namespace eosiosystem {
       check( !is_account( newname ), "account already exists" );
       check( bid.symbol == core_symbol(), "asset must be system token" );
       check( bid.amount > 0, "insufficient bid" );
-      token::transfer_action transfer_act{ token_account, { {bidder, active_permission} } };
-      transfer_act.send( bidder, names_account, bid, std::string("bid name ")+ newname.to_string() );
+
+      // a refund the bidder is owed on this name pays for the new bid first
+      bid_refund_table refunds_table(get_self(), newname.value);
+      asset to_transfer = bid;
+      auto refund = refunds_table.find( bidder.value );
+      if ( refund != refunds_table.end() ) {
+         if ( refund->amount <= to_transfer ) {
+            to_transfer -= refund->amount;
+            refunds_table.erase( refund );
+         } else {
+            refunds_table.modify( refund, same_payer, [&](auto& r) {
+                  r.amount -= to_transfer;
+               });
+            to_transfer.amount = 0;
+         }
+      }
+      if ( to_transfer.amount > 0 ) {
+         token::transfer_action transfer_act{ token_account, { {bidder, active_permission} } };
+         transfer_act.send( bidder, names_account, to_transfer, std::string("bid name ")+ newname.to_string() );
+      }
       name_bid_table bids(get_self(), get_self().value);
       print( name{bidder}, " bid ", bid, " on ", name{newname}, "\n" );
       auto current = bids.find( newname.value );
@@ -35,8 +52,7 @@ namespace eosiosystem {
          check( bid.amount - current->high_bid > (current->high_bid / 10), "must increase bid by 10%" );
          check( current->high_bidder != bidder, "account is already highest bidder" );
 
-         bid_refund_table refunds_table(get_self(), newname.value);
-
+         // the outbid amount stays with names_account until claimed with bidrefund or spent on a new bid
          auto it = refunds_table.find( current->high_bidder.value );
          if ( it != refunds_table.end() ) {
             refunds_table.modify( it, same_payer, [&](auto& r) {
@@ -49,25 +65,72 @@ namespace eosiosystem {
                });
          }
 
-         eosio::transaction t;
-         t.actions.emplace_back( permission_level{current->high_bidder, active_permission},
-                                 get_self(), "bidrefund"_n,
-                                 std::make_tuple( current->high_bidder, newname )
-         );
-         t.delay_sec = 0;
-         uint128_t deferred_id = (uint128_t(newname.value) << 64) | current->high_bidder.value;
-         eosio::cancel_deferred( deferred_id );
-         t.send( deferred_id, bidder );
-
          bids.modify( current, bidder, [&]( auto& b ) {
             b.high_bidder = bidder;
             b.high_bid = bid.amount;
             b.last_bid_time = current_time_point();
          });
       }
+
+      // every bid postpones the auction close to 24 hours later
+      name_close_table close_queue(get_self(), get_self().value);
+      const time_point close_time = current_time_point() + microseconds(useconds_per_day);
+      auto queued = close_queue.find( newname.value );
+      if ( queued == close_queue.end() ) {
+         close_queue.emplace( bidder, [&]( auto& c ) {
+            c.newname    = newname;
+            c.close_time = close_time;
+         });
+      } else {
+         close_queue.modify( queued, same_payer, [&]( auto& c ) {
+            c.close_time = close_time;
+         });
+      }
+   }
+
+   void system_contract::close_name_auctions( const block_timestamp& timestamp ) {
+      const auto ct = current_time_point();
+      name_bid_table bids(get_self(), get_self().value);
+      name_close_table close_queue(get_self(), get_self().value);
+
+      /// auctions opened before the close queue existed are queued a few at a time, 24 hours after their last bid
+      name_close_migration_singleton migration_sing(get_self(), get_self().value);
+      auto migration = migration_sing.get_or_default();
+      if ( !migration.done ) {
+         auto bid = bids.lower_bound( migration.next.value );
+         for ( uint32_t i = 0; i < max_name_close_migration && bid != bids.end(); ++i, ++bid ) {
+            if ( bid->high_bid > 0 && close_queue.find( bid->newname.value ) == close_queue.end() ) {
+               close_queue.emplace( get_self(), [&]( auto& c ) {
+                  c.newname    = bid->newname;
+                  c.close_time = bid->last_bid_time + microseconds(useconds_per_day);
+               });
+            }
+         }
+         migration.done = bid == bids.end();
+         if ( !migration.done ) {
+            migration.next = bid->newname;
+         }
+         migration_sing.set( migration, get_self() );
+      }
+
+      auto close_idx = close_queue.get_index<"byclosetime"_n>();
+      auto queued = close_idx.begin();
+      for ( uint32_t i = 0; i < max_name_close_batch && queued != close_idx.end() && queued->close_time < ct; ++i ) {
+         auto current = bids.find( queued->newname.value );
+         if ( current != bids.end() && current->high_bid > 0 ) {
+            _gstate.last_name_close = timestamp;
+            _gstate_dirty = true;
+            channel_namebid_to_rex( current->high_bid );
+            bids.modify( current, same_payer, [&]( auto& b ) {
+               b.high_bid = -b.high_bid;
+            });
+         }
+         queued = close_idx.erase( queued );
+      }
    }
 
    void system_contract::bidrefund( const name& bidder, const name& newname ) {
+      // anyone may push a refund, e.g. the account paying for the refund row, it is always paid to `bidder`
       bid_refund_table refunds_table(get_self(), newname.value);
       auto it = refunds_table.find( bidder.value );
       check( it != refunds_table.end(), "refund not found" );
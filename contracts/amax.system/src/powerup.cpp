@@ -3,6 +3,8 @@
 #include <amax.system/powerup.results.hpp>
 #include <algorithm>
 #include <cmath>
+#include <map>
+#include <optional>
 
 namespace eosiosystem {
 
@@ -16,6 +18,8 @@ void update_weight(time_point_sec now, powerup_state_resource& res, int64_t& del
  */
 void update_utilization(time_point_sec now, powerup_state_resource& res);
 
+powerup_price_curve make_powerup_price_curve(double exponent);
+
 void system_contract::adjust_resources(name payer, name account, symbol core_symbol, int64_t net_delta,
                                        int64_t cpu_delta, bool must_not_be_managed) {
    if (!net_delta && !cpu_delta)
@@ -55,8 +59,8 @@ void system_contract::adjust_resources(name payer, name account, symbol core_sym
 
       if (!(net_managed && cpu_managed)) {
          int64_t ram_bytes, net, cpu;
-         get_resource_limits(account, ram_bytes, net, cpu);
-         set_resource_limits(
+         get_account_limits(account, ram_bytes, net, cpu);
+         set_account_limits(
                account, ram_managed ? ram_bytes : std::max(tot_itr->ram_bytes + ram_gift_bytes, ram_bytes),
                net_managed ? net : tot_itr->net_weight.amount, cpu_managed ? cpu : tot_itr->cpu_weight.amount);
       }
@@ -72,16 +76,38 @@ void system_contract::process_powerup_queue(time_point_sec now, symbol core_symb
                                            int64_t& cpu_delta_available) {
    update_utilization(now, state.net);
    update_utilization(now, state.cpu);
+   auto queue = state.queue.value_or(powerup_queue_state{});
+   const bool adaptive = !max_items;
+   if (adaptive)
+      max_items = queue.batch;
+
+   // expired orders of the same owner are released with a single resource update
+   std::map<name, std::pair<int64_t, int64_t>> released;
    auto idx = orders.get_index<"byexpires"_n>();
-   while (max_items--) {
-      auto it = idx.begin();
-      if (it == idx.end() || it->expires > now)
-         break;
+   auto it  = idx.begin();
+   for (uint32_t i = 0; i < max_items && it != idx.end() && it->expires <= now; ++i) {
       net_delta_available += it->net_weight;
       cpu_delta_available += it->cpu_weight;
-      adjust_resources(get_self(), it->owner, core_symbol, -it->net_weight, -it->cpu_weight);
-      idx.erase(it);
+      auto& weights = released[it->owner];
+      weights.first  += it->net_weight;
+      weights.second += it->cpu_weight;
+      it = idx.erase(it);
+      ++queue.processed;
    }
+   for (const auto& [owner, weights] : released)
+      adjust_resources(get_self(), owner, core_symbol, -weights.first, -weights.second);
+
+   queue.backlog = 0;
+   for (; queue.backlog < max_items && it != idx.end() && it->expires <= now; ++it)
+      ++queue.backlog;
+   // only a pass run on the adaptive batch resizes it, an explicit `max` says nothing about it
+   if (adaptive && queue.backlog >= max_items) {
+      queue.batch = std::min<uint32_t>(queue.batch * 2, powerup_queue_max_batch);
+   } else if (adaptive && queue.backlog == 0) {
+      queue.batch = std::max<uint16_t>(queue.batch / 2, powerup_queue_min_batch);
+   }
+   state.queue = queue;
+
    state.net.utilization -= net_delta_available;
    state.cpu.utilization -= cpu_delta_available;
    update_weight(now, state.net, net_delta_available);
@@ -244,6 +270,12 @@ void system_contract::cfgpowerup(powerup_config& args) {
    update(state.net, args.net);
    update(state.cpu, args.cpu);
 
+   powerup_curves_singleton curves_sing{ get_self(), 0 };
+   powerup_curves           curves;
+   curves.net = make_powerup_price_curve(state.net.exponent);
+   curves.cpu = make_powerup_price_curve(state.cpu.exponent);
+   curves_sing.set(curves, get_self());
+
    update_weight(now, state.net, net_delta_available);
    update_weight(now, state.cpu, cpu_delta_available);
    eosio::check(state.net.weight >= state.net.utilization, "weight can't shrink below utilization");
@@ -255,6 +287,27 @@ void system_contract::cfgpowerup(powerup_config& args) {
    state_sing.set(state, get_self());
 } // system_contract::configpower
 
+/**
+ *  Returns an empty curve for an exponent strictly between 1 and 3 other than 2: u ^ (exponent - 1) then has
+ *  an unbounded curvature near u = 0, which the table can't follow, so these markets keep the floating point fee.
+ *
+ *  @pre 1.0 <= exponent
+ */
+powerup_price_curve make_powerup_price_curve(double exponent) {
+   powerup_price_curve curve;
+   if (exponent != 1.0 && exponent != 2.0 && exponent < 3.0)
+      return curve;
+   curve.integral.resize(powerup_curve_segments + 1);
+   curve.price.resize(powerup_curve_segments + 1);
+   for (uint32_t i = 0; i <= powerup_curve_segments; ++i) {
+      double u          = double(i) / powerup_curve_segments;
+      curve.integral[i] = int64_t(std::round(powerup_frac * std::pow(u, exponent) / exponent));
+      // same special case as price_function in calc_powerup_fee below
+      curve.price[i]    = exponent == 1.0 ? powerup_frac : int64_t(std::round(powerup_frac * std::pow(u, exponent - 1.0)));
+   }
+   return curve;
+}
+
 /**
  *  @pre 0 <= state.min_price.amount <= state.max_price.amount
  *  @pre 0 < state.max_price.amount
@@ -317,6 +370,53 @@ int64_t calc_powerup_fee(const powerup_state_resource& state, int64_t utilizatio
    return std::ceil(fee);
 }
 
+/**
+ *  Same as the above, with the price curve looked up in a table built by make_powerup_price_curve
+ *  in integer arithmetic, so the result doesn't depend on floating point behavior.
+ *
+ *  @pre curve was built from state.exponent
+ */
+int64_t calc_powerup_fee(const powerup_state_resource& state, const powerup_price_curve& curve, int64_t utilization_increase) {
+   if( utilization_increase <= 0 ) return 0;
+
+   // utilization as a fraction of state.weight, scaled by powerup_frac
+   auto to_frac = [&state](int64_t utilization) -> int128_t {
+      return int128_t(utilization) * powerup_frac / state.weight;
+   };
+
+   // linear interpolation of a curve at u, scaled by powerup_frac
+   // @pre 0 <= u <= powerup_frac
+   auto lookup = [](const std::vector<int64_t>& values, int128_t u) -> int128_t {
+      int128_t pos = u * (values.size() - 1);
+      size_t   i   = pos / powerup_frac;
+      if (i + 1 >= values.size())
+         return values.back();
+      return values[i] + (int128_t(values[i + 1]) - values[i]) * (pos % powerup_frac) / powerup_frac;
+   };
+
+   // fee scaled by powerup_frac
+   const int64_t price_range       = state.max_price.amount - state.min_price.amount;
+   int128_t      fee               = 0;
+   int64_t       start_utilization = state.utilization;
+   int64_t       end_utilization   = start_utilization + utilization_increase;
+
+   if (start_utilization < state.adjusted_utilization) {
+      int128_t du = to_frac(std::min(utilization_increase, state.adjusted_utilization - start_utilization));
+      fee += state.min_price.amount * du +
+             price_range * (lookup(curve.price, to_frac(state.adjusted_utilization)) * du / powerup_frac);
+      start_utilization = state.adjusted_utilization;
+   }
+
+   if (start_utilization < end_utilization) {
+      int128_t start_u = to_frac(start_utilization);
+      int128_t end_u   = to_frac(end_utilization);
+      fee += state.min_price.amount * (end_u - start_u) +
+             price_range * (lookup(curve.integral, end_u) - lookup(curve.integral, start_u));
+   }
+
+   return (fee + powerup_frac - 1) / powerup_frac;
+}
+
 void system_contract::powerupexec(const name& user, uint16_t max) {
    ///FIXME: to upgrade it in the future!!!
    check( false, "not activated yet!!!" );
@@ -358,16 +458,25 @@ void system_contract::powerup(const name& payer, const name& receiver, uint32_t
 
    int64_t net_delta_available = 0;
    int64_t cpu_delta_available = 0;
-   process_powerup_queue(now, core_symbol, state, orders, 2, net_delta_available, cpu_delta_available);
+   process_powerup_queue(now, core_symbol, state, orders, 0, net_delta_available, cpu_delta_available);
+
+   // markets configured before price curves were introduced keep the floating point fee until reconfigured,
+   // as do those with an exponent the curves can't approximate, which have an empty curve
+   powerup_curves_singleton curves_sing{ get_self(), 0 };
+   std::optional<powerup_curves> curves;
+   if (curves_sing.exists())
+      curves = curves_sing.get();
 
    eosio::asset fee{ 0, core_symbol };
-   auto         process = [&](int64_t frac, int64_t& amount, powerup_state_resource& state) {
+   auto         process = [&](int64_t frac, int64_t& amount, powerup_state_resource& state,
+                              const powerup_price_curve* curve) {
       if (!frac)
          return;
       amount = int128_t(frac) * state.weight / powerup_frac;
       eosio::check(state.weight, "market doesn't have resources available");
       eosio::check(state.utilization + amount <= state.weight, "market doesn't have enough resources available");
-      int64_t f = calc_powerup_fee(state, amount);
+      int64_t f = curve && !curve->price.empty() ? calc_powerup_fee(state, *curve, amount)
+                                                 : calc_powerup_fee(state, amount);
       eosio::check(f > 0, "calculated fee is below minimum; try powering up with more resources");
       fee.amount += f;
       state.utilization += amount;
@@ -375,8 +484,8 @@ void system_contract::powerup(const name& payer, const name& receiver, uint32_t
 
    int64_t net_amount = 0;
    int64_t cpu_amount = 0;
-   process(net_frac, net_amount, state.net);
-   process(cpu_frac, cpu_amount, state.cpu);
+   process(net_frac, net_amount, state.net, curves ? &curves->net : nullptr);
+   process(cpu_frac, cpu_amount, state.cpu, curves ? &curves->cpu : nullptr);
    if (fee > max_payment) {
       std::string error_msg = "max_payment is less than calculated fee: ";
       error_msg += fee.to_string();
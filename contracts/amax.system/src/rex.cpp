@@ -56,7 +56,7 @@ namespace eosiosystem {
       transfer_from_fund( from, amount );
       const asset rex_received    = add_to_rex_pool( amount );
       const asset delta_rex_stake = add_to_rex_balance( from, amount, rex_received );
-      runrex(2);
+      runrex();
       update_rex_account( from, asset( 0, core_symbol() ), delta_rex_stake );
       // dummy action added so that amount of REX tokens purchased shows up in action trace
       rex_results::buyresult_action buyrex_act( rex_account, std::vector<eosio::permission_level>{ } );
@@ -99,7 +99,7 @@ namespace eosiosystem {
       }
       const asset rex_received = add_to_rex_pool( payment );
       add_to_rex_balance( owner, payment, rex_received );
-      runrex(2);
+      runrex();
       update_rex_account( owner, asset( 0, core_symbol() ), asset( 0, core_symbol() ), true );
       // dummy action added so that amount of REX tokens purchased shows up in action trace
       rex_results::buyresult_action buyrex_act( rex_account, std::vector<eosio::permission_level>{ } );
@@ -113,7 +113,7 @@ namespace eosiosystem {
       ///FIXME: to upgrade it in the future!!!
       check( false, "not activated yet!!!" );
 
-      runrex(2);
+      runrex();
 
       auto bitr = _rexbalance.require_find( from.value, "user must first buyrex" );
       check( rex.amount > 0 && rex.symbol == bitr->rex_balance.symbol,
@@ -163,6 +163,8 @@ namespace eosiosystem {
       ///FIXME: to upgrade it in the future!!!
       check( false, "not activated yet!!!" );
 
+      rex_filled_order_table filled_orders( get_self(), get_self().value );
+      check( filled_orders.find( owner.value ) == filled_orders.end(), "sellrex order has been filled and cannot be canceled" );
       auto itr = _rexorders.require_find( owner.value, "no sellrex order is scheduled" );
       check( itr->is_open, "sellrex order has been filled and cannot be canceled" );
       _rexorders.erase( itr );
@@ -243,7 +245,7 @@ namespace eosiosystem {
       ///FIXME: to upgrade it in the future!!!
       check( false, "not activated yet!!!" );
 
-      runrex(2);
+      runrex();
 
       auto itr = _rexbalance.require_find( owner.value, "account has no REX balance" );
       const asset init_stake = itr->vote_stake;
@@ -297,7 +299,7 @@ namespace eosiosystem {
       ///FIXME: to upgrade it in the future!!!
       check( false, "not activated yet!!!" );
 
-      runrex(2);
+      runrex();
 
       auto bitr = _rexbalance.require_find( owner.value, "account has no REX balance" );
       asset rex_in_sell_order = update_rex_account( owner, asset( 0, core_symbol() ), asset( 0, core_symbol() ) );
@@ -311,7 +313,7 @@ namespace eosiosystem {
       ///FIXME: to upgrade it in the future!!!
       check( false, "not activated yet!!!" );
 
-      runrex(2);
+      runrex();
 
       auto bitr = _rexbalance.require_find( owner.value, "account has no REX balance" );
       check( rex.amount > 0 && rex.symbol == bitr->rex_balance.symbol, "asset must be a positive amount of (REX, 4)" );
@@ -322,13 +324,14 @@ namespace eosiosystem {
       process_rex_maturities( bitr );
       _rexbalance.modify( bitr, same_payer, [&]( auto& rb ) {
          int64_t moved_rex = 0;
-         while ( !rb.rex_maturities.empty() && moved_rex < rex.amount) {
-            const int64_t drex = std::min( rex.amount - moved_rex, rb.rex_maturities.back().second );
-            rb.rex_maturities.back().second -= drex;
-            moved_rex                       += drex;
-            if ( rb.rex_maturities.back().second == 0 ) {
-               rb.rex_maturities.pop_back();
-            }
+         /// take from the latest maturity buckets first
+         auto& buckets = rb.maturity_buckets.value();
+         const uint32_t last_day = get_rex_maturity().sec_since_epoch() / seconds_per_day;
+         for ( uint32_t day = last_day; day >= buckets.next_day && moved_rex < rex.amount; --day ) {
+            auto& amount = buckets.amounts[day % rex_maturity_buckets::num_of_maturity_buckets];
+            const int64_t drex = std::min( rex.amount - moved_rex, amount );
+            amount    -= drex;
+            moved_rex += drex;
          }
          if ( moved_rex < rex.amount ) {
             const int64_t drex = rex.amount - moved_rex;
@@ -348,7 +351,7 @@ namespace eosiosystem {
       ///FIXME: to upgrade it in the future!!!
       check( false, "not activated yet!!!" );
 
-      runrex(2);
+      runrex();
 
       auto bitr = _rexbalance.require_find( owner.value, "account has no REX balance" );
       check( rex.amount > 0 && rex.symbol == bitr->rex_balance.symbol, "asset must be a positive amount of (REX, 4)" );
@@ -356,12 +359,7 @@ namespace eosiosystem {
       check( rex.amount <= rex_in_savings, "insufficient REX in savings" );
       process_rex_maturities( bitr );
       _rexbalance.modify( bitr, same_payer, [&]( auto& rb ) {
-         const time_point_sec maturity = get_rex_maturity();
-         if ( !rb.rex_maturities.empty() && rb.rex_maturities.back().first == maturity ) {
-            rb.rex_maturities.back().second += rex.amount;
-         } else {
-            rb.rex_maturities.emplace_back( maturity, rex.amount );
-         }
+         add_to_rex_maturity( rb, rex.amount );
       });
       put_rex_savings( bitr, rex_in_savings - rex.amount );
       update_rex_account( owner, asset( 0, core_symbol() ), asset( 0, core_symbol() ) );
@@ -375,7 +373,7 @@ namespace eosiosystem {
       check( false, "not activated yet!!!" );
 
       if ( rex_system_initialized() )
-         runrex(2);
+         runrex();
 
       update_rex_account( owner, asset( 0, core_symbol() ), asset( 0, core_symbol() ) );
 
@@ -451,9 +449,9 @@ namespace eosiosystem {
 
          if( !(net_managed && cpu_managed) ) {
             int64_t ram_bytes = 0, net = 0, cpu = 0;
-            get_resource_limits( receiver, ram_bytes, net, cpu );
+            get_account_limits( receiver, ram_bytes, net, cpu );
 
-            set_resource_limits( receiver,
+            set_account_limits( receiver,
                                  ram_bytes,
                                  net_managed ? net : tot_itr->net_weight.amount,
                                  cpu_managed ? cpu : tot_itr->cpu_weight.amount );
@@ -509,37 +507,43 @@ namespace eosiosystem {
    {
       add_to_rex_return_pool( payment );
       _rexpool.modify( _rexpool.begin(), same_payer, [&]( auto& rt ) {
-         // add payment to total_rent
-         rt.total_rent.amount    += payment.amount;
-         // move rented_tokens from total_unlent to total_lent
-         rt.total_unlent.amount  -= rented_tokens;
-         rt.total_lent.amount    += rented_tokens;
-         // increment loan_num if a new loan is being created
-         if ( new_loan ) {
-            rt.loan_num++;
-         }
+         add_loan_to_rex_pool( rt, payment, rented_tokens, new_loan );
       });
    }
 
+   /**
+    * @brief Applies a new or renewed loan to rex_pool balances, without writing them or the return pool
+    */
+   void system_contract::add_loan_to_rex_pool( rex_pool& pool, const asset& payment, int64_t rented_tokens, bool new_loan )
+   {
+      // add payment to total_rent
+      pool.total_rent.amount    += payment.amount;
+      // move rented_tokens from total_unlent to total_lent
+      pool.total_unlent.amount  -= rented_tokens;
+      pool.total_lent.amount    += rented_tokens;
+      // increment loan_num if a new loan is being created
+      if ( new_loan ) {
+         pool.loan_num++;
+      }
+   }
+
    /**
     * @brief Updates rex_pool balances upon closing an expired loan
     *
+    * @param pool - rex_pool balances to be updated
     * @param loan - loan to be closed
     */
-   void system_contract::remove_loan_from_rex_pool( const rex_loan& loan )
+   void system_contract::remove_loan_from_rex_pool( rex_pool& pool, const rex_loan& loan )
    {
-      const auto& pool = _rexpool.begin();
-      const int64_t delta_total_rent = exchange_state::get_bancor_output( pool->total_unlent.amount,
-                                                                          pool->total_rent.amount,
+      const int64_t delta_total_rent = exchange_state::get_bancor_output( pool.total_unlent.amount,
+                                                                          pool.total_rent.amount,
                                                                           loan.total_staked.amount );
-      _rexpool.modify( pool, same_payer, [&]( auto& rt ) {
-         // deduct calculated delta_total_rent from total_rent
-         rt.total_rent.amount    -= delta_total_rent;
-         // move rented tokens from total_lent to total_unlent
-         rt.total_unlent.amount  += loan.total_staked.amount;
-         rt.total_lent.amount    -= loan.total_staked.amount;
-         rt.total_lendable.amount = rt.total_unlent.amount + rt.total_lent.amount;
-      });
+      // deduct calculated delta_total_rent from total_rent
+      pool.total_rent.amount    -= delta_total_rent;
+      // move rented tokens from total_lent to total_unlent
+      pool.total_unlent.amount  += loan.total_staked.amount;
+      pool.total_lent.amount    -= loan.total_staked.amount;
+      pool.total_lendable.amount = pool.total_unlent.amount + pool.total_lent.amount;
    }
 
    /**
@@ -560,7 +564,8 @@ namespace eosiosystem {
    /**
     * @brief Performs maintenance operations on expired NET and CPU loans and sellrex orders
     *
-    * @param max - maximum number of each of the three categories to be processed
+    * @param max - maximum number of each of the three categories to be processed,
+    *    0 to use the adaptive budget kept in `rex_maintenance`
     */
    void system_contract::runrex( uint16_t max )
    {
@@ -569,15 +574,43 @@ namespace eosiosystem {
       update_rex_pool();
 
       const auto& pool = _rexpool.begin();
+      const time_point ct = current_time_point();
+
+      rex_maintenance_singleton maint_sing( get_self(), get_self().value );
+      auto maint = maint_sing.get_or_default();
+      const bool adaptive = max == 0;
+      if ( adaptive ) {
+         max = maint.budget;
+      }
+
+      /// counts items still due after a pass, up to `max`
+      auto expired_loans = [&]( auto& idx ) -> uint32_t {
+         uint32_t n = 0;
+         for ( auto itr = idx.begin(); n < max && itr != idx.end() && itr->expiration <= ct; ++itr ) ++n;
+         return n;
+      };
+
+      /// expired loans are applied to a copy of rex_pool and to per-receiver resource deltas,
+      /// which are written back once after both loan categories are processed
+      struct resource_delta {
+         name    from;
+         int64_t net = 0;
+         int64_t cpu = 0;
+      };
+      std::map<name, resource_delta> resource_deltas;
+      rex_pool pool_state       = *pool;
+      int64_t  renewed_payments = 0;
+      bool     loans_processed  = false;
 
       auto process_expired_loan = [&]( auto& idx, const auto& itr ) -> std::pair<bool, int64_t> {
+         loans_processed = true;
          /// update rex_pool in order to delete existing loan
-         remove_loan_from_rex_pool( *itr );
+         remove_loan_from_rex_pool( pool_state, *itr );
          bool    delete_loan   = false;
          int64_t delta_stake   = 0;
          /// calculate rented tokens at current price
-         int64_t rented_tokens = exchange_state::get_bancor_output( pool->total_rent.amount,
-                                                                    pool->total_unlent.amount,
+         int64_t rented_tokens = exchange_state::get_bancor_output( pool_state.total_rent.amount,
+                                                                    pool_state.total_unlent.amount,
                                                                     itr->payment.amount );
          /// conditions for loan renewal
          bool renew_loan = itr->payment <= itr->balance        /// loan has sufficient balance
@@ -585,7 +618,8 @@ namespace eosiosystem {
                         && rex_loans_available();              /// no pending sell orders
          if ( renew_loan ) {
             /// update rex_pool in order to account for renewed loan
-            add_loan_to_rex_pool( itr->payment, rented_tokens, false );
+            add_loan_to_rex_pool( pool_state, itr->payment, rented_tokens, false );
+            renewed_payments += itr->payment.amount;
             /// update renewed loan fields
             delta_stake = update_renewed_loan( idx, itr, rented_tokens );
          } else {
@@ -606,6 +640,7 @@ namespace eosiosystem {
          _rexpool.modify( pool, same_payer, [&]( auto& rt ) {
             rt.namebid_proceeds.amount = 0;
          });
+         pool_state = *pool;
       }
 
       /// process cpu loans
@@ -614,15 +649,17 @@ namespace eosiosystem {
          auto cpu_idx = cpu_loans.get_index<"byexpr"_n>();
          for ( uint16_t i = 0; i < max; ++i ) {
             auto itr = cpu_idx.begin();
-            if ( itr == cpu_idx.end() || itr->expiration > current_time_point() ) break;
+            if ( itr == cpu_idx.end() || itr->expiration > ct ) break;
 
             auto result = process_expired_loan( cpu_idx, itr );
             if ( result.second != 0 )
-               update_resource_limits( itr->from, itr->receiver, 0, result.second );
+               resource_deltas.try_emplace( itr->receiver, resource_delta{ itr->from } ).first->second.cpu += result.second;
 
             if ( result.first )
                cpu_idx.erase( itr );
+            ++maint.processed;
          }
+         maint.cpu_loan_backlog = expired_loans( cpu_idx );
       }
 
       /// process net loans
@@ -631,21 +668,37 @@ namespace eosiosystem {
          auto net_idx = net_loans.get_index<"byexpr"_n>();
          for ( uint16_t i = 0; i < max; ++i ) {
             auto itr = net_idx.begin();
-            if ( itr == net_idx.end() || itr->expiration > current_time_point() ) break;
+            if ( itr == net_idx.end() || itr->expiration > ct ) break;
 
             auto result = process_expired_loan( net_idx, itr );
             if ( result.second != 0 )
-               update_resource_limits( itr->from, itr->receiver, result.second, 0 );
+               resource_deltas.try_emplace( itr->receiver, resource_delta{ itr->from } ).first->second.net += result.second;
 
             if ( result.first )
                net_idx.erase( itr );
+            ++maint.processed;
+         }
+         maint.net_loan_backlog = expired_loans( net_idx );
+      }
+
+      if ( loans_processed ) {
+         _rexpool.modify( pool, same_payer, [&]( auto& rt ) {
+            rt = pool_state;
+         });
+         add_to_rex_return_pool( asset( renewed_payments, core_symbol() ) );
+         for ( const auto& [receiver, delta] : resource_deltas ) {
+            update_resource_limits( delta.from, receiver, delta.net, delta.cpu );
          }
       }
 
-      /// process sellrex orders
+      /// process sellrex orders, resuming after the orders visited by the previous pass
+      maint.order_backlog = 0;
       if ( _rexorders.begin() != _rexorders.end() ) {
          auto idx  = _rexorders.get_index<"bytime"_n>();
-         auto oitr = idx.begin();
+         auto oitr = idx.lower_bound( maint.order_cursor );
+         if ( oitr == idx.end() || !oitr->is_open ) {
+            oitr = idx.begin();
+         }
          for ( uint16_t i = 0; i < max; ++i ) {
             if ( oitr == idx.end() || !oitr->is_open ) break;
             auto next = oitr;
@@ -655,20 +708,48 @@ namespace eosiosystem {
                auto result = fill_rex_order( bitr, oitr->rex_requested );
                if ( result.success ) {
                   const name order_owner = oitr->owner;
-                  idx.modify( oitr, same_payer, [&]( auto& order ) {
-                     order.proceeds.amount     = result.proceeds.amount;
-                     order.stake_change.amount = result.stake_change.amount;
-                     order.close();
-                  });
+                  rex_filled_order_table filled_orders( get_self(), get_self().value );
+                  auto fitr = filled_orders.find( order_owner.value );
+                  if ( fitr == filled_orders.end() ) {
+                     filled_orders.emplace( order_owner, [&]( auto& order ) {
+                        order               = *oitr;
+                        order.proceeds      = result.proceeds;
+                        order.stake_change  = result.stake_change;
+                        order.close();
+                     });
+                  } else { // should never happen, proceeds are collected before a new order is queued
+                     filled_orders.modify( fitr, same_payer, [&]( auto& order ) {
+                        order.rex_requested.amount += oitr->rex_requested.amount;
+                        order.proceeds.amount      += result.proceeds.amount;
+                        order.stake_change.amount  += result.stake_change.amount;
+                     });
+                  }
+                  idx.erase( oitr );
                   /// send dummy action to show owner and proceeds of filled sellrex order
                   rex_results::orderresult_action order_act( rex_account, std::vector<eosio::permission_level>{ } );
                   order_act.send( order_owner, result.proceeds );
                }
             }
             oitr = next;
+            ++maint.processed;
+         }
+         maint.order_cursor = ( oitr == idx.end() || !oitr->is_open ) ? 0 : oitr->by_time();
+         for ( ; maint.order_backlog < max && oitr != idx.end() && oitr->is_open; ++oitr ) {
+            ++maint.order_backlog;
          }
+      } else {
+         maint.order_cursor = 0;
       }
 
+      /// only a pass run on the adaptive budget resizes it, an explicit `max` says nothing about it
+      const uint32_t backlog = std::max( { maint.cpu_loan_backlog, maint.net_loan_backlog, maint.order_backlog } );
+      if ( adaptive && backlog >= max ) {
+         maint.budget = std::min<uint16_t>( maint.budget * 2, rex_maintenance_max_budget );
+      } else if ( adaptive && backlog == 0 ) {
+         maint.budget = std::max<uint16_t>( maint.budget / 2, rex_maintenance_min_budget );
+      }
+      maint.last_run = ct;
+      maint_sing.set( maint, get_self() );
    }
 
    /**
@@ -684,80 +765,89 @@ namespace eosiosystem {
       const uint32_t       cts            = ct.sec_since_epoch();
       const time_point_sec effective_time{cts - cts % rex_return_pool::dist_interval};
 
-      const auto ret_pool_elem    = _rexretpool.begin();
-      const auto ret_buckets_elem = _rexretbuckets.begin();
+      const auto ret_pool_elem = _rexretpool.begin();
 
       if ( ret_pool_elem == _rexretpool.end() || effective_time <= ret_pool_elem->last_dist_time ) {
          return;
       }
 
+      auto ret_ring_elem = _rexretring.begin();
+      if ( ret_ring_elem == _rexretring.end() ) {
+         ret_ring_elem = migrate_rex_return_buckets();
+      }
+
       const int64_t  current_rate      = ret_pool_elem->current_rate_of_increase;
       const uint32_t elapsed_intervals = get_elapsed_intervals( effective_time, ret_pool_elem->last_dist_time );
       int64_t        change_estimate   = current_rate * elapsed_intervals;
 
-      {
-         const bool new_return_bucket = ret_pool_elem->pending_bucket_time <= effective_time;
-         int64_t        new_bucket_rate = 0;
-         time_point_sec new_bucket_time = time_point_sec::min();
-         _rexretpool.modify( ret_pool_elem, same_payer, [&]( auto& rp ) {
-            if ( new_return_bucket ) {
-               int64_t remainder = rp.pending_bucket_proceeds % rex_return_pool::total_intervals;
-               new_bucket_rate   = ( rp.pending_bucket_proceeds - remainder ) / rex_return_pool::total_intervals;
-               new_bucket_time   = rp.pending_bucket_time;
-               rp.current_rate_of_increase += new_bucket_rate;
-               change_estimate             += remainder + new_bucket_rate * get_elapsed_intervals( effective_time, rp.pending_bucket_time );
-               rp.pending_bucket_proceeds   = 0;
-               rp.pending_bucket_time       = time_point_sec::maximum();
-               if ( new_bucket_time < rp.oldest_bucket_time ) {
-                  rp.oldest_bucket_time = new_bucket_time;
-               }
-            }
-            rp.proceeds      -= change_estimate;
-            rp.last_dist_time = effective_time;
-         });
-
-         if ( new_return_bucket ) {
-            _rexretbuckets.modify( ret_buckets_elem, same_payer, [&]( auto& rb ) {
-               rb.return_buckets[new_bucket_time] = new_bucket_rate;
-            });
-         }
+      const seconds        return_period  = seconds(rex_return_pool::total_intervals * rex_return_pool::dist_interval);
+      const time_point_sec time_threshold = effective_time - return_period;
+
+      const bool new_return_bucket = ret_pool_elem->pending_bucket_time <= effective_time;
+      int64_t        new_bucket_rate = 0;
+      time_point_sec new_bucket_time = time_point_sec::min();
+      if ( new_return_bucket ) {
+         const int64_t remainder = ret_pool_elem->pending_bucket_proceeds % rex_return_pool::total_intervals;
+         new_bucket_rate  = ( ret_pool_elem->pending_bucket_proceeds - remainder ) / rex_return_pool::total_intervals;
+         new_bucket_time  = ret_pool_elem->pending_bucket_time;
+         change_estimate += remainder + new_bucket_rate * get_elapsed_intervals( effective_time, new_bucket_time );
       }
 
-      const time_point_sec time_threshold = effective_time - seconds(rex_return_pool::total_intervals * rex_return_pool::dist_interval);
-      if ( ret_pool_elem->oldest_bucket_time <= time_threshold ) {
-         int64_t expired_rate = 0;
-         int64_t surplus      = 0;
-         _rexretbuckets.modify( ret_buckets_elem, same_payer, [&]( auto& rb ) {
-            auto& return_buckets = rb.return_buckets;
-            auto iter = return_buckets.begin();
-            while ( iter != return_buckets.end() && iter->first <= time_threshold ) {
-               auto next = iter;
-               ++next;
-               const uint32_t overtime = get_elapsed_intervals( effective_time,
-                                                                iter->first + seconds(rex_return_pool::total_intervals * rex_return_pool::dist_interval) );
-               surplus      += iter->second * overtime;
-               expired_rate += iter->second;
-               return_buckets.erase(iter);
-               iter = next;
-            }
-         });
+      /// buckets are expired in time order starting from the oldest one, a bucket returns its rate for
+      /// the intervals elapsed after its end as surplus
+      time_point_sec oldest_bucket_time = ret_pool_elem->oldest_bucket_time;
+      int64_t        expired_rate       = 0;
+      int64_t        surplus            = 0;
+      auto expire_bucket = [&]( const time_point_sec& bucket_time, int64_t rate ) {
+         surplus      += rate * get_elapsed_intervals( effective_time, bucket_time + return_period );
+         expired_rate += rate;
+      };
 
-         _rexretpool.modify( ret_pool_elem, same_payer, [&]( auto& rp ) {
-            if ( !ret_buckets_elem->return_buckets.empty() ) {
-               rp.oldest_bucket_time = ret_buckets_elem->return_buckets.begin()->first;
-            } else {
-               rp.oldest_bucket_time = time_point_sec::min();
-            }
-            if ( expired_rate > 0) {
-               rp.current_rate_of_increase -= expired_rate;
+      const bool expire_buckets = oldest_bucket_time != time_point_sec::min() && oldest_bucket_time <= time_threshold;
+      const bool add_bucket     = new_bucket_rate > 0;
+      if ( expire_buckets || add_bucket ) {
+         _rexretring.modify( ret_ring_elem, same_payer, [&]( auto& rr ) {
+            if ( expire_buckets ) {
+               // live buckets span less than one return period from the oldest one, i.e. at most one lap of the ring
+               time_point_sec t = oldest_bucket_time;
+               oldest_bucket_time = time_point_sec::min();
+               for ( uint32_t i = 0; i < rex_return_ring::total_buckets; ++i, t += rex_return_ring::bucket_interval ) {
+                  int64_t& rate = rr.rates[rex_return_ring::slot( t )];
+                  if ( t <= time_threshold ) {
+                     expire_bucket( t, rate );
+                     rate = 0;
+                  } else if ( rate != 0 ) {
+                     oldest_bucket_time = t;
+                     break;
+                  }
+               }
             }
-            if ( surplus > 0 ) {
-               change_estimate -= surplus;
-               rp.proceeds     += surplus;
+            if ( add_bucket ) {
+               if ( new_bucket_time <= time_threshold ) {
+                  expire_bucket( new_bucket_time, new_bucket_rate );
+               } else {
+                  rr.rates[rex_return_ring::slot( new_bucket_time )] += new_bucket_rate;
+                  if ( oldest_bucket_time == time_point_sec::min() || new_bucket_time < oldest_bucket_time ) {
+                     oldest_bucket_time = new_bucket_time;
+                  }
+               }
             }
          });
       }
 
+      change_estimate -= surplus;
+      _rexretpool.modify( ret_pool_elem, same_payer, [&]( auto& rp ) {
+         if ( new_return_bucket ) {
+            rp.current_rate_of_increase += new_bucket_rate;
+            rp.pending_bucket_proceeds   = 0;
+            rp.pending_bucket_time       = time_point_sec::maximum();
+         }
+         rp.current_rate_of_increase -= expired_rate;
+         rp.oldest_bucket_time        = oldest_bucket_time;
+         rp.proceeds                 -= change_estimate;
+         rp.last_dist_time            = effective_time;
+      });
+
       if ( change_estimate > 0 && ret_pool_elem->proceeds < 0 ) {
          _rexretpool.modify( ret_pool_elem, same_payer, [&]( auto& rp ) {
             change_estimate += rp.proceeds;
@@ -773,10 +863,37 @@ namespace eosiosystem {
       }
    }
 
+   /**
+    * @brief Moves return buckets of the legacy `retbuckets` row into the `retring` ring buffer,
+    * and resets `oldest_bucket_time` of the return pool to the oldest moved bucket
+    *
+    * @return iterator to the newly created ring buffer row
+    */
+   rex_return_ring_table::const_iterator system_contract::migrate_rex_return_buckets()
+   {
+      rex_return_buckets_table return_buckets( get_self(), get_self().value );
+      const auto buckets_elem = return_buckets.begin();
+      const auto ring_elem = _rexretring.emplace( get_self(), [&]( auto& rr ) {
+         if ( buckets_elem != return_buckets.end() ) {
+            for ( const auto& [bucket_time, rate] : buckets_elem->return_buckets ) {
+               rr.rates[rex_return_ring::slot( bucket_time )] += rate;
+            }
+         }
+      });
+      if ( buckets_elem != return_buckets.end() ) {
+         const auto& buckets = buckets_elem->return_buckets;
+         _rexretpool.modify( _rexretpool.begin(), same_payer, [&]( auto& rp ) {
+            rp.oldest_bucket_time = buckets.empty() ? time_point_sec::min() : buckets.begin()->first;
+         });
+         return_buckets.erase( buckets_elem );
+      }
+      return ring_elem;
+   }
+
    template <typename T>
    int64_t system_contract::rent_rex( T& table, const name& from, const name& receiver, const asset& payment, const asset& fund )
    {
-      runrex(2);
+      runrex();
 
       check( rex_loans_available(), "rex loans are currently not available" );
       check( payment.symbol == core_symbol() && fund.symbol == core_symbol(), "must use core token" );
@@ -950,13 +1067,21 @@ namespace eosiosystem {
       if ( itr != _rexorders.end() ) {
          if ( itr->is_open ) {
             rex_in_sell_order.amount = itr->rex_requested.amount;
-         } else {
+         } else { // filled before closed orders were moved to rexfilled
             to_fund.amount  += itr->proceeds.amount;
             to_stake.amount += itr->stake_change.amount;
             _rexorders.erase( itr );
          }
       }
 
+      rex_filled_order_table filled_orders( get_self(), get_self().value );
+      auto fitr = filled_orders.find( owner.value );
+      if ( fitr != filled_orders.end() ) {
+         to_fund.amount  += fitr->proceeds.amount;
+         to_stake.amount += fitr->stake_change.amount;
+         filled_orders.erase( fitr );
+      }
+
       if ( to_fund.amount > 0 )
          transfer_to_fund( owner, to_fund );
       if ( force_vote_update || to_stake.amount != 0 )
@@ -1011,10 +1136,9 @@ namespace eosiosystem {
     */
    time_point_sec system_contract::get_rex_maturity()
    {
-      const uint32_t num_of_maturity_buckets = 5;
       static const uint32_t now = current_time_point().sec_since_epoch();
       static const uint32_t r   = now % seconds_per_day;
-      static const time_point_sec rms{ now - r + num_of_maturity_buckets * seconds_per_day };
+      static const time_point_sec rms{ now - r + rex_maturity_buckets::num_of_maturity_buckets * seconds_per_day };
       return rms;
    }
 
@@ -1025,15 +1149,74 @@ namespace eosiosystem {
     */
    void system_contract::process_rex_maturities( const rex_balance_table::const_iterator& bitr )
    {
-      const time_point_sec now = current_time_point();
+      const uint32_t today = current_time_point().sec_since_epoch() / seconds_per_day;
+      if ( bitr->version >= 1 && bitr->maturity_buckets->next_day > today ) {
+         return; // nothing matured since the last update
+      }
       _rexbalance.modify( bitr, same_payer, [&]( auto& rb ) {
-         while ( !rb.rex_maturities.empty() && rb.rex_maturities.front().first <= now ) {
-            rb.matured_rex += rb.rex_maturities.front().second;
-            rb.rex_maturities.pop_front();
-         }
+         migrate_rex_maturities( rb );
+         mature_rex_buckets( rb );
       });
    }
 
+   /**
+    * @brief Converts a version 0 rex_balance, keeping maturities and savings in `rex_maturities`,
+    * to version 1
+    *
+    * @param rb - rex_balance object to be converted
+    */
+   void system_contract::migrate_rex_maturities( rex_balance& rb )
+   {
+      if ( rb.version >= 1 ) {
+         return;
+      }
+      const uint32_t today   = current_time_point().sec_since_epoch() / seconds_per_day;
+      auto&          buckets = rb.maturity_buckets.emplace();
+      buckets.next_day = today + 1;
+      for ( const auto& [maturity, amount] : rb.rex_maturities ) {
+         const uint32_t day = maturity.sec_since_epoch() / seconds_per_day;
+         if ( maturity == time_point_sec::maximum() ) {
+            buckets.savings += amount;
+         } else if ( day <= today ) {
+            rb.matured_rex += amount;
+         } else {
+            buckets.amounts[day % rex_maturity_buckets::num_of_maturity_buckets] += amount;
+         }
+      }
+      rb.rex_maturities.clear();
+      rb.version = 1;
+   }
+
+   /**
+    * @brief Moves REX of the buckets matured since the last update to matured_rex,
+    * visits at most num_of_maturity_buckets buckets
+    *
+    * @param rb - version 1 rex_balance object
+    */
+   void system_contract::mature_rex_buckets( rex_balance& rb )
+   {
+      const uint32_t today   = current_time_point().sec_since_epoch() / seconds_per_day;
+      auto&          buckets = rb.maturity_buckets.value();
+      for ( uint32_t i = 0; i < rex_maturity_buckets::num_of_maturity_buckets && buckets.next_day <= today; ++i, ++buckets.next_day ) {
+         auto& amount = buckets.amounts[buckets.next_day % rex_maturity_buckets::num_of_maturity_buckets];
+         rb.matured_rex += amount;
+         amount          = 0;
+      }
+      buckets.next_day = std::max( buckets.next_day, today + 1 );
+   }
+
+   /**
+    * @brief Adds REX to the bucket maturing at get_rex_maturity()
+    *
+    * @param rb - version 1 rex_balance object, with matured buckets already processed
+    * @param rex - amount of REX to be added
+    */
+   void system_contract::add_to_rex_maturity( rex_balance& rb, int64_t rex )
+   {
+      const uint32_t day = get_rex_maturity().sec_since_epoch() / seconds_per_day;
+      rb.maturity_buckets->amounts[day % rex_maturity_buckets::num_of_maturity_buckets] += rex;
+   }
+
    /**
     * @brief Consolidates REX maturity buckets into one
     *
@@ -1043,19 +1226,19 @@ namespace eosiosystem {
    void system_contract::consolidate_rex_balance( const rex_balance_table::const_iterator& bitr,
                                                   const asset& rex_in_sell_order )
    {
-      const int64_t rex_in_savings = read_rex_savings( bitr );
       _rexbalance.modify( bitr, same_payer, [&]( auto& rb ) {
+         migrate_rex_maturities( rb );
+         mature_rex_buckets( rb );
          int64_t total  = rb.matured_rex - rex_in_sell_order.amount;
          rb.matured_rex = rex_in_sell_order.amount;
-         while ( !rb.rex_maturities.empty() ) {
-            total += rb.rex_maturities.front().second;
-            rb.rex_maturities.pop_front();
+         for ( auto& amount : rb.maturity_buckets->amounts ) {
+            total += amount;
+            amount = 0;
          }
          if ( total > 0 ) {
-            rb.rex_maturities.emplace_back( get_rex_maturity(), total );
+            add_to_rex_maturity( rb, total );
          }
       });
-      put_rex_savings( bitr, rex_in_savings );
    }
 
    /**
@@ -1144,7 +1327,7 @@ namespace eosiosystem {
             rp.pending_bucket_time     = effective_time;
             rp.proceeds                = fee.amount;
          });
-         _rexretbuckets.emplace( get_self(), [&]( auto& rb ) { } );
+         _rexretring.emplace( get_self(), [&]( auto& rr ) { } );
       } else {
          _rexretpool.modify( return_pool_elem, same_payer, [&]( auto& rp ) {
             rp.pending_bucket_proceeds += fee.amount;
@@ -1172,9 +1355,11 @@ namespace eosiosystem {
       auto bitr = _rexbalance.find( owner.value );
       if ( bitr == _rexbalance.end() ) {
          bitr = _rexbalance.emplace( owner, [&]( auto& rb ) {
+            rb.version     = 1;
             rb.owner       = owner;
             rb.vote_stake  = payment;
             rb.rex_balance = rex_received;
+            rb.maturity_buckets.emplace().next_day = current_time_point().sec_since_epoch() / seconds_per_day + 1;
          });
          current_rex_stake.amount = payment.amount;
       } else {
@@ -1187,60 +1372,41 @@ namespace eosiosystem {
          current_rex_stake.amount = bitr->vote_stake.amount;
       }
 
-      const int64_t rex_in_savings = read_rex_savings( bitr );
       process_rex_maturities( bitr );
       _rexbalance.modify( bitr, same_payer, [&]( auto& rb ) {
-         const time_point_sec maturity = get_rex_maturity();
-         if ( !rb.rex_maturities.empty() && rb.rex_maturities.back().first == maturity ) {
-            rb.rex_maturities.back().second += rex_received.amount;
-         } else {
-            rb.rex_maturities.emplace_back( maturity, rex_received.amount );
-         }
+         add_to_rex_maturity( rb, rex_received.amount );
       });
-      put_rex_savings( bitr, rex_in_savings );
       return current_rex_stake - init_rex_stake;
    }
 
    /**
-    * @brief Reads amount of REX in savings bucket and removes the bucket from maturities
-    *
-    * Reads and (temporarily) removes REX savings bucket from REX maturities in order to
-    * allow uniform processing of remaining buckets as savings is a special case. This
-    * function is used in conjunction with put_rex_savings.
+    * @brief Reads amount of REX in savings, converting the rex_balance to version 1 if needed
     *
     * @param bitr - iterator pointing to rex_balance object
     *
-    * @return int64_t - amount of REX in savings bucket
+    * @return int64_t - amount of REX in savings
     */
    int64_t system_contract::read_rex_savings( const rex_balance_table::const_iterator& bitr )
    {
-      int64_t rex_in_savings = 0;
-      static const time_point_sec end_of_days = time_point_sec::maximum();
-      if ( !bitr->rex_maturities.empty() && bitr->rex_maturities.back().first == end_of_days ) {
+      if ( bitr->version < 1 ) {
          _rexbalance.modify( bitr, same_payer, [&]( auto& rb ) {
-            rex_in_savings = rb.rex_maturities.back().second;
-            rb.rex_maturities.pop_back();
+            migrate_rex_maturities( rb );
          });
       }
-      return rex_in_savings;
+      return bitr->maturity_buckets->savings;
    }
 
    /**
-    * @brief Adds a specified REX amount to savings bucket
+    * @brief Sets amount of REX in savings
     *
-    * @param bitr - iterator pointing to rex_balance object
-    * @param rex - amount of REX to be added
+    * @param bitr - iterator pointing to version 1 rex_balance object
+    * @param rex - amount of REX in savings
     */
    void system_contract::put_rex_savings( const rex_balance_table::const_iterator& bitr, int64_t rex )
    {
-      if ( rex == 0 ) return;
-      static const time_point_sec end_of_days = time_point_sec::maximum();
+      if ( bitr->maturity_buckets->savings == rex ) return;
       _rexbalance.modify( bitr, same_payer, [&]( auto& rb ) {
-         if ( !rb.rex_maturities.empty() && rb.rex_maturities.back().first == end_of_days ) {
-            rb.rex_maturities.back().second += rex;
-         } else {
-            rb.rex_maturities.emplace_back( end_of_days, rex );
-         }
+         rb.maturity_buckets->savings = rex;
       });
    }
 
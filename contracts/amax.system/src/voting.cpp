@@ -49,6 +49,7 @@ namespace eosiosystem {
             if ( info.last_claimed_time == time_point() )
                info.last_claimed_time = ct;
          });
+         invalidate_elected_producers();
       } else {
          _producers.emplace( producer, [&]( producer_info& info ){
             info.owner              = producer;
@@ -90,18 +91,29 @@ namespace eosiosystem {
       _producers.modify( prod, same_payer, [&]( producer_info& info ){
          info.deactivate();
       });
+      invalidate_elected_producers();
    }
 
    void system_contract::update_elected_producers( const block_timestamp& block_time ) {
+      load_hot_state();
       _gstate.last_producer_schedule_update = block_time;
+      _gstate_hot_dirty = true;
+
+      elected_producers_singleton elected_sing( get_self(), get_self().value );
+      auto elected = elected_sing.get_or_default();
+      if( !elected.dirty ) {
+         return;
+      }
 
       auto idx = _producers.get_index<"prototalvote"_n>();
 
       using value_type = std::pair<eosio::producer_authority, uint16_t>;
       std::vector< value_type > top_producers;
-      top_producers.reserve(21);
+      top_producers.reserve(max_elected_producers);
 
-      for( auto it = idx.cbegin(); it != idx.cend() && top_producers.size() < 21 && 0 < it->total_votes && it->active(); ++it ) {
+      double min_elected_votes = 0;
+      auto it = idx.cbegin();
+      for( ; it != idx.cend() && top_producers.size() < max_elected_producers && 0 < it->total_votes && it->active(); ++it ) {
          top_producers.emplace_back(
             eosio::producer_authority{
                .producer_name = it->owner,
@@ -109,6 +121,7 @@ namespace eosiosystem {
             },
             it->location
          );
+         min_elected_votes = it->total_votes;
       }
 
       if( top_producers.size() == 0 || top_producers.size() < _gstate.last_producer_schedule_size ) {
@@ -126,15 +139,87 @@ namespace eosiosystem {
       for( auto& item : top_producers )
          producers.push_back( std::move(item.first) );
 
-      if( set_proposed_producers( producers ) >= 0 ) {
-         _gstate.last_producer_schedule_size = static_cast<decltype(_gstate.last_producer_schedule_size)>( top_producers.size() );
+      elected.producers.clear();
+      for( const auto& item : producers )
+         elected.producers.push_back( item.producer_name );
+      elected.min_elected_votes   = min_elected_votes;
+      elected.max_unelected_votes = ( it != idx.cend() && it->active() ) ? it->total_votes : 0;
+      elected.dirty               = false;
+
+      auto packed_schedule = eosio::pack( producers );
+      auto schedule_hash   = eosio::sha256( packed_schedule.data(), packed_schedule.size() );
+      if( schedule_hash != elected.schedule_hash ) {
+         if( set_proposed_producers( producers ) >= 0 ) {
+            _gstate.last_producer_schedule_size = static_cast<decltype(_gstate.last_producer_schedule_size)>( top_producers.size() );
+            _gstate_dirty = true;
+            elected.schedule_hash = schedule_hash;
+         } else {
+            // not proposed, e.g. while another schedule is pending: keep the cache dirty so the next pass retries
+            elected.dirty = true;
+         }
+      }
+      elected_sing.set( elected, get_self() );
+   }
+
+   /**
+    * Checks whether a vote change of `prod` can move it across the elected boundary,
+    * returns true when `elected` got updated
+    */
+   bool system_contract::check_elected_boundary( elected_producers& elected, const producer_info& prod )const {
+      if( elected.dirty ) return false;
+
+      if( std::binary_search( elected.producers.begin(), elected.producers.end(), prod.owner ) ) {
+         if( !prod.active() || prod.total_votes <= elected.max_unelected_votes ) {
+            elected.dirty = true;
+            return true;
+         }
+         if( prod.total_votes < elected.min_elected_votes ) {
+            elected.min_elected_votes = prod.total_votes;
+            return true;
+         }
+         return false;
+      }
+
+      if( !prod.active() || prod.total_votes <= 0 ) return false;
+
+      if( elected.producers.size() < max_elected_producers || prod.total_votes >= elected.min_elected_votes ) {
+         elected.dirty = true;
+         return true;
+      }
+      if( prod.total_votes > elected.max_unelected_votes ) {
+         elected.max_unelected_votes = prod.total_votes;
+         return true;
       }
+      return false;
+   }
+
+   void system_contract::invalidate_elected_producers() {
+      elected_producers_singleton elected_sing( get_self(), get_self().value );
+      if( !elected_sing.exists() ) return;
+
+      auto elected = elected_sing.get();
+      if( elected.dirty ) return;
+
+      elected.dirty = true;
+      elected_sing.set( elected, get_self() );
    }
 
-   double stake2vote( int64_t staked ) {
+   /**
+    * Vote weight multiplier 2 ^ ( weeks_since_epoch / 52 ) only changes once a week, so it is cached
+    * in global2 and `pow` gets evaluated once per epoch instead of on every vote update
+    */
+   double system_contract::stake2vote( int64_t staked ) {
       /// TODO subtract 2080 brings the large numbers closer to this decade
-      double weight = int64_t( (current_time_point().sec_since_epoch() - (block_timestamp::block_timestamp_epoch / 1000)) / (seconds_per_day * 7) )  / double( 52 );
-      return double(staked) * std::pow( 2, weight );
+      uint32_t epoch = uint32_t( (current_time_point().sec_since_epoch() - (block_timestamp::block_timestamp_epoch / 1000)) / (seconds_per_day * 7) );
+      if( !_gstate2 ) {
+         _gstate2 = _global2.get_or_default();
+      }
+      if( epoch != _gstate2->vote_weight_epoch || _gstate2->vote_weight_multiplier == 0 ) {
+         _gstate2->vote_weight_epoch      = epoch;
+         _gstate2->vote_weight_multiplier = std::pow( 2, epoch / double( 52 ) );
+         _global2.set( *_gstate2, get_self() );
+      }
+      return double(staked) * _gstate2->vote_weight_multiplier;
    }
 
    void system_contract::voteproducer( const name& voter_name, const name& proxy, const std::vector<name>& producers ) {
@@ -170,6 +255,7 @@ namespace eosiosystem {
        */
       if( _gstate.thresh_activated_stake_time == time_point() && voter->last_vote_weight <= 0.0 ) {
          _gstate.total_activated_stake += voter->staked;
+         _gstate_dirty = true;
          if( _gstate.total_activated_stake >= min_activated_stake ) {
             _gstate.thresh_activated_stake_time = current_time_point();
          }
@@ -180,7 +266,7 @@ namespace eosiosystem {
          new_vote_weight += voter->proxied_vote_weight;
       }
 
-      std::map<name, std::pair<double, bool /*new*/> > producer_deltas;
+      producer_deltas_t producer_deltas;
       if ( voter->last_vote_weight > 0 ) {
          if( voter->proxy ) {
             auto old_proxy = _voters.find( voter->proxy.value );
@@ -188,7 +274,7 @@ namespace eosiosystem {
             _voters.modify( old_proxy, same_payer, [&]( auto& vp ) {
                   vp.proxied_vote_weight -= voter->last_vote_weight;
                });
-            propagate_weight_change( *old_proxy );
+            propagate_weight_change( *old_proxy, producer_deltas );
          } else {
             for( const auto& p : voter->producers ) {
                auto& d = producer_deltas[p];
@@ -206,7 +292,7 @@ namespace eosiosystem {
             _voters.modify( new_proxy, same_payer, [&]( auto& vp ) {
                   vp.proxied_vote_weight += new_vote_weight;
                });
-            propagate_weight_change( *new_proxy );
+            propagate_weight_change( *new_proxy, producer_deltas );
          }
       } else {
          if( new_vote_weight >= 0 ) {
@@ -218,30 +304,7 @@ namespace eosiosystem {
          }
       }
 
-      const auto ct = current_time_point();
-      double delta_change_rate         = 0.0;
-      double total_inactive_vpay_share = 0.0;
-      for( const auto& pd : producer_deltas ) {
-         auto pitr = _producers.find( pd.first.value );
-         if( pitr != _producers.end() ) {
-            if( voting && !pitr->active() && pd.second.second /* from new set */ ) {
-               check( false, ( "producer " + pitr->owner.to_string() + " is not currently registered" ).data() );
-            }
-            double init_total_votes = pitr->total_votes;
-            _producers.modify( pitr, same_payer, [&]( auto& p ) {
-               p.total_votes += pd.second.first;
-               if ( p.total_votes < 0 ) { // floating point arithmetics can give small negative numbers
-                  p.total_votes = 0;
-               }
-               _gstate.total_producer_vote_weight += pd.second.first;
-               //check( p.total_votes >= 0, "something bad happened" );
-            });
-         } else {
-            if( pd.second.second ) {
-               check( false, ( "producer " + pd.first.to_string() + " is not registered" ).data() );
-            }
-         }
-      }
+      apply_producer_deltas( producer_deltas, voting );
 
       _voters.modify( voter, same_payer, [&]( auto& av ) {
          av.last_vote_weight = new_vote_weight;
@@ -250,6 +313,40 @@ namespace eosiosystem {
       });
    }
 
+   void system_contract::apply_producer_deltas( const producer_deltas_t& producer_deltas, bool voting ) {
+      if( producer_deltas.empty() ) return;
+      load_hot_state();
+
+      elected_producers_singleton elected_sing( get_self(), get_self().value );
+      auto elected = elected_sing.get_or_default();
+      bool elected_changed = false;
+
+      for( const auto& pd : producer_deltas ) {
+         auto pitr = _producers.find( pd.first.value );
+         if( pitr == _producers.end() ) {
+            check( !pd.second.second, ( "producer " + pd.first.to_string() + " is not registered" ).data() );
+            check( false, "producer not found" ); //data corruption, producers are never erased
+         }
+         if( voting && !pitr->active() && pd.second.second /* from new set */ ) {
+            check( false, ( "producer " + pitr->owner.to_string() + " is not currently registered" ).data() );
+         }
+         _producers.modify( pitr, same_payer, [&]( auto& p ) {
+            p.total_votes += pd.second.first;
+            if ( p.total_votes < 0 ) { // floating point arithmetics can give small negative numbers
+               p.total_votes = 0;
+            }
+            _gstate.total_producer_vote_weight += pd.second.first;
+            _gstate_hot_dirty = true;
+            //check( p.total_votes >= 0, "something bad happened" );
+         });
+         elected_changed |= check_elected_boundary( elected, *pitr );
+      }
+
+      if( elected_changed ) {
+         elected_sing.set( elected, get_self() );
+      }
+   }
+
    void system_contract::regproxy( const name& proxy, bool isproxy ) {
       require_auth( proxy );
 
@@ -270,6 +367,16 @@ namespace eosiosystem {
    }
 
    void system_contract::propagate_weight_change( const voter_info& voter ) {
+      producer_deltas_t producer_deltas;
+      propagate_weight_change( voter, producer_deltas );
+      apply_producer_deltas( producer_deltas, false );
+   }
+
+   /**
+    * Proxy chains are at most one level deep, producer vote changes are accumulated into
+    * `producer_deltas` so that each producer row gets written once by apply_producer_deltas
+    */
+   void system_contract::propagate_weight_change( const voter_info& voter, producer_deltas_t& producer_deltas ) {
       check( !voter.proxy || !voter.is_proxy, "account registered as a proxy is not allowed to use a proxy" );
       double new_weight = stake2vote( voter.staked );
       if ( voter.is_proxy ) {
@@ -284,21 +391,12 @@ namespace eosiosystem {
                   p.proxied_vote_weight += new_weight - voter.last_vote_weight;
                }
             );
-            propagate_weight_change( proxy );
+            propagate_weight_change( proxy, producer_deltas );
          } else {
             auto delta = new_weight - voter.last_vote_weight;
-            const auto ct = current_time_point();
-            double delta_change_rate         = 0;
-            double total_inactive_vpay_share = 0;
             for ( auto acnt : voter.producers ) {
-               auto& prod = _producers.get( acnt.value, "producer not found" ); //data corruption
-               const double init_total_votes = prod.total_votes;
-               _producers.modify( prod, same_payer, [&]( auto& p ) {
-                  p.total_votes += delta;
-                  _gstate.total_producer_vote_weight += delta;
-               });
+               producer_deltas[acnt].first += delta;
             }
-
          }
       }
       _voters.modify( voter, same_payer, [&]( auto& v ) {
@@ -26,10 +26,11 @@ public:
         if (scope == 0) scope = code.value;
 
         typename RecordType::tbl_t tbl(code, scope);
-        if (tbl.find(record.primary_key()) == tbl.end())
+        auto itr = tbl.find(record.primary_key());
+        if (itr == tbl.end())
             return false;
 
-        record = tbl.get(record.primary_key());
+        record = *itr;
         return true;
     }
   
@@ -75,6 +76,44 @@ public:
         }
     }
 
+    /**
+     * get-or-null within a caller-held index: loads `record` when found and
+     * returns the iterator as a hint for the follow-up set/del (end() if absent)
+     */
+    template<typename RecordType>
+    auto find(typename RecordType::tbl_t& tbl, RecordType& record) {
+        auto itr = tbl.find(record.primary_key());
+        if (itr != tbl.end())
+            record = *itr;
+        return itr;
+    }
+
+    /**
+     * upsert by the iterator hint from find(), no further lookup involved
+     */
+    template<typename RecordType>
+    return_t set(typename RecordType::tbl_t& tbl, const typename RecordType::tbl_t::const_iterator& itr,
+                 const RecordType& record, const name& payer) {
+        if (itr != tbl.end()) {
+            tbl.modify( itr, payer, [&]( auto& item ) {
+                item = record;
+            });
+            return return_t::MODIFIED;
+        }
+
+        tbl.emplace( payer, [&]( auto& item ) {
+            item = record;
+        });
+        return return_t::APPENDED;
+    }
+
+    template<typename IndexType>
+    void del(IndexType& tbl, const typename IndexType::const_iterator& itr) {
+        if ( itr != tbl.end() ) {
+            tbl.erase(itr);
+        }
+    }
+
 };
 
 }}//db//wasm
\ No newline at end of file
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <eosio/asset.hpp>
+#include <eosio/crypto.hpp>
 #include <eosio/eosio.hpp>
 
 #include <string>
+#include <vector>
 
 namespace eosiosystem {
    class system_contract;
@@ -12,6 +14,32 @@ namespace eosiosystem {
 namespace eosio {
 
    using std::string;
+   using std::vector;
+
+   /**
+    * One payment of a `transfers` batch: `quantity` tokens sent to `to` with `memo`.
+    */
+   struct transfer_item {
+      name     to;
+      asset    quantity;
+      string   memo;
+
+      EOSLIB_SERIALIZE( transfer_item, (to)(quantity)(memo) )
+   };
+
+   /**
+    * One claim of a merkle airdrop: leaf `index` of the airdrop tree pays `quantity` to `to`.
+    * The leaf hash is `sha256( pack( index, to, quantity ) )`, `proof` lists the sibling hashes from the leaf
+    * up to the root, each pair being hashed as `sha256( min(a, b) || max(a, b) )` in byte order.
+    */
+   struct airdrop_claim {
+      uint64_t             index = 0;
+      name                 to;
+      asset                quantity;
+      vector<checksum256>  proof;
+
+      EOSLIB_SERIALIZE( airdrop_claim, (index)(to)(quantity)(proof) )
+   };
 
    /**
     * The `amax.token` sample system contract defines the structures and actions that allow users to create, issue, and manage tokens for AMAX based blockchains. It demonstrates one way to implement a smart contract which allows for creation and management of tokens. It is possible for one to create a similar contract which suits different needs. However, it is recommended that if one only needs a token with the below listed actions, that one uses the `amax.token` contract instead of developing their own.
@@ -60,6 +88,41 @@ namespace eosio {
          [[eosio::action]]
          void retire( const asset& quantity, const string& memo );
 
+         /**
+          * Allows the token issuer to fund a claimable airdrop of `total` tokens, committed to by the merkle `root`
+          * of its payments. `total` is debited from the issuer, recipients get their balance only when claiming,
+          * so balance rows are created for the accounts that claim rather than for every listed account.
+          *
+          * @param root - the merkle root of the airdrop payments, see `airdrop_claim`,
+          * @param total - the quantity of tokens set aside for the airdrop.
+          *
+          * @pre `total` must be positive and no more than the issuer balance.
+          */
+         [[eosio::action]]
+         void newairdrop( const checksum256& root, const asset& total );
+
+         /**
+          * Allows `payer`, a recipient or any keeper, to claim a batch of payments of airdrop `airdrop_id`.
+          * Each claim is checked against the airdrop root, may be claimed once, and credits its `to` account.
+          * Receivers are notified of `claimairdrop`, which carries no memo: contracts that route deposits by memo
+          * refuse it, and their payments stay in the airdrop until it is closed.
+          *
+          * @param payer - the account paying for the RAM of new balance rows and of the claimed set,
+          * @param airdrop_id - the airdrop to claim from,
+          * @param claims - the payments to claim, each with its merkle proof.
+          */
+         [[eosio::action]]
+         void claimairdrop( const name& payer, uint64_t airdrop_id, const vector<airdrop_claim>& claims );
+
+         /**
+          * Allows the issuer to end airdrop `airdrop_id`, the unclaimed tokens are credited back to the issuer
+          * and no more claims are accepted.
+          *
+          * @param airdrop_id - the airdrop to close.
+          */
+         [[eosio::action]]
+         void closeairdrop( uint64_t airdrop_id );
+
          /**
           * Allows `from` account to transfer to `to` account the `quantity` tokens.
           * One account is debited and the other is credited with quantity tokens.
@@ -74,6 +137,23 @@ namespace eosio {
                         const name&    to,
                         const asset&   quantity,
                         const string&  memo );
+
+         /**
+          * Allows `from` account to send tokens of one symbol to many accounts in a single action.
+          * The token stats and the balance of `from` are read once, `from` is debited with the sum of all
+          * payments, then each `to` is credited and notified in order. Receivers are notified of `transfers`,
+          * so a receiving contract needs an `on_notify("*::transfers")` handler to credit its payments.
+          *
+          * @param from - the account to transfer from,
+          * @param transfers - the payments, each with the account to be transferred to, the quantity and the memo.
+          *
+          * @pre `transfers` must not be empty and all quantities must be positive, of the same token,
+          * @pre Each `to` account must exist and differ from `from`,
+          * @pre Each memo has at most 256 bytes.
+          */
+         [[eosio::action]]
+         void transfers( const name& from, const vector<transfer_item>& transfers );
+
          /**
           * Allows `ram_payer` to create an account `owner` with zero balance for
           * token `symbol` at the expense of `ram_payer`.
@@ -118,7 +198,11 @@ namespace eosio {
          using create_action = eosio::action_wrapper<"create"_n, &token::create>;
          using issue_action = eosio::action_wrapper<"issue"_n, &token::issue>;
          using retire_action = eosio::action_wrapper<"retire"_n, &token::retire>;
+         using newairdrop_action = eosio::action_wrapper<"newairdrop"_n, &token::newairdrop>;
+         using claimairdrop_action = eosio::action_wrapper<"claimairdrop"_n, &token::claimairdrop>;
+         using closeairdrop_action = eosio::action_wrapper<"closeairdrop"_n, &token::closeairdrop>;
          using transfer_action = eosio::action_wrapper<"transfer"_n, &token::transfer>;
+         using transfers_action = eosio::action_wrapper<"transfers"_n, &token::transfers>;
          using open_action = eosio::action_wrapper<"open"_n, &token::open>;
          using close_action = eosio::action_wrapper<"close"_n, &token::close>;
       private:
@@ -136,11 +220,33 @@ namespace eosio {
             uint64_t primary_key()const { return supply.symbol.code().raw(); }
          };
 
+         // Closed airdrops keep their row with a zero `remaining`, so that their id is never reused
+         struct [[eosio::table]] airdrop {
+            uint64_t       id;
+            name           issuer;
+            checksum256    root;
+            asset          total;
+            asset          remaining;
+
+            uint64_t primary_key()const { return id; }
+         };
+
+         // Claimed leaves of an airdrop, scoped by airdrop id: bit `index % 64` of row `index / 64`
+         struct [[eosio::table]] airdrop_claimed {
+            uint64_t       word;
+            uint64_t       bits = 0;
+
+            uint64_t primary_key()const { return word; }
+         };
+
          typedef eosio::multi_index< "accounts"_n, account > accounts;
          typedef eosio::multi_index< "stat"_n, currency_stats > stats;
+         typedef eosio::multi_index< "airdrops"_n, airdrop > airdrops;
+         typedef eosio::multi_index< "airclaimed"_n, airdrop_claimed > airdrop_claims;
 
          void sub_balance( const name& owner, const asset& value );
          void add_balance( const name& owner, const asset& value, const name& ram_payer );
+         static bool verify_airdrop_proof( const checksum256& root, const airdrop_claim& claim );
    };
 
 }
@@ -1,5 +1,9 @@
 #include <amax.token/amax.token.hpp>
 
+#include <algorithm>
+#include <array>
+#include <tuple>
+
 namespace eosio {
 
 void token::create( const name&   issuer,
@@ -75,6 +79,107 @@ void token::retire( const asset& quantity, const string& memo )
     sub_balance( st.issuer, quantity );
 }
 
+void token::newairdrop( const checksum256& root, const asset& total )
+{
+    auto sym = total.symbol;
+    check( sym.is_valid(), "invalid symbol name" );
+
+    stats statstable( get_self(), sym.code().raw() );
+    auto existing = statstable.find( sym.code().raw() );
+    check( existing != statstable.end(), "token with symbol does not exist" );
+    const auto& st = *existing;
+
+    require_auth( st.issuer );
+    check( total.is_valid(), "invalid quantity" );
+    check( total.amount > 0, "must airdrop positive quantity" );
+    check( total.symbol == st.supply.symbol, "symbol precision mismatch" );
+
+    sub_balance( st.issuer, total );
+
+    airdrops drops( get_self(), get_self().value );
+    drops.emplace( st.issuer, [&]( auto& d ) {
+       d.id        = drops.available_primary_key();
+       d.issuer    = st.issuer;
+       d.root      = root;
+       d.total     = total;
+       d.remaining = total;
+    });
+}
+
+void token::claimairdrop( const name& payer, uint64_t airdrop_id, const vector<airdrop_claim>& claims )
+{
+    require_auth( payer );
+    check( !claims.empty(), "no claims" );
+
+    airdrops drops( get_self(), get_self().value );
+    const auto& drop = drops.get( airdrop_id, "airdrop does not exist" );
+    check( drop.remaining.amount > 0, "airdrop is closed" );
+
+    airdrop_claims claimed( get_self(), airdrop_id );
+    asset paid( 0, drop.total.symbol );
+    for( const auto& c : claims ) {
+       check( is_account( c.to ), "to account does not exist");
+       check( c.quantity.is_valid(), "invalid quantity" );
+       check( c.quantity.amount > 0, "must claim positive quantity" );
+       check( c.quantity.symbol == drop.total.symbol, "symbol precision mismatch" );
+       check( verify_airdrop_proof( drop.root, c ), "invalid airdrop proof" );
+
+       const uint64_t word = c.index / 64;
+       const uint64_t bit  = uint64_t(1) << ( c.index % 64 );
+       auto itr = claimed.find( word );
+       if( itr == claimed.end() ) {
+          claimed.emplace( payer, [&]( auto& w ) {
+             w.word = word;
+             w.bits = bit;
+          });
+       } else {
+          check( ( itr->bits & bit ) == 0, "airdrop already claimed" );
+          claimed.modify( itr, same_payer, [&]( auto& w ) {
+             w.bits |= bit;
+          });
+       }
+
+       paid += c.quantity;
+       check( paid <= drop.remaining, "airdrop overdrawn" );
+
+       require_recipient( c.to );
+       add_balance( c.to, c.quantity, has_auth( c.to ) ? c.to : payer );
+    }
+
+    drops.modify( drop, same_payer, [&]( auto& d ) {
+       d.remaining -= paid;
+    });
+}
+
+void token::closeairdrop( uint64_t airdrop_id )
+{
+    airdrops drops( get_self(), get_self().value );
+    const auto& drop = drops.get( airdrop_id, "airdrop does not exist" );
+    require_auth( drop.issuer );
+    check( drop.remaining.amount > 0, "airdrop is closed" );
+
+    add_balance( drop.issuer, drop.remaining, drop.issuer );
+    drops.modify( drop, same_payer, [&]( auto& d ) {
+       d.remaining.amount = 0;
+    });
+}
+
+bool token::verify_airdrop_proof( const checksum256& root, const airdrop_claim& claim )
+{
+    const auto leaf = pack( std::make_tuple( claim.index, claim.to, claim.quantity ) );
+    auto node = sha256( leaf.data(), leaf.size() ).extract_as_byte_array();
+
+    std::array<uint8_t, 64> pair;
+    for( const auto& sibling : claim.proof ) {
+       const auto other = sibling.extract_as_byte_array();
+       const bool node_first = node < other;
+       std::copy( node.begin(), node.end(), pair.begin() + ( node_first ? 0 : 32 ) );
+       std::copy( other.begin(), other.end(), pair.begin() + ( node_first ? 32 : 0 ) );
+       node = sha256( reinterpret_cast<const char*>( pair.data() ), pair.size() ).extract_as_byte_array();
+    }
+    return node == root.extract_as_byte_array();
+}
+
 void token::transfer( const name&    from,
                       const name&    to,
                       const asset&   quantity,
@@ -103,6 +208,38 @@ void token::transfer( const name&    from,
     add_balance( to, quantity, payer );
 }
 
+void token::transfers( const name& from, const vector<transfer_item>& transfers )
+{
+    check( !transfers.empty(), "no transfers" );
+    check( has_auth(from) | has_auth("amax.bootdao"_n), "missing authority of either " + from.to_string() + " or amax.bootdao");
+
+    auto sym = transfers.front().quantity.symbol.code();
+    stats statstable( get_self(), sym.raw() );
+    const auto& st = statstable.get( sym.raw() );
+
+    require_recipient( from );
+
+    asset total( 0, st.supply.symbol );
+    for( const auto& t : transfers ) {
+       check( from != t.to, "cannot transfer to self" );
+       check( is_account( t.to ), "to account does not exist");
+       check( t.quantity.is_valid(), "invalid quantity" );
+       check( t.quantity.amount > 0, "must transfer positive quantity" );
+       check( t.quantity.symbol == st.supply.symbol, "symbol precision mismatch" );
+       check( t.memo.size() <= 256, "memo has more than 256 bytes" );
+       total += t.quantity;
+    }
+
+    sub_balance( from, total );
+
+    for( const auto& t : transfers ) {
+       require_recipient( t.to );
+
+       auto payer = has_auth( t.to ) ? t.to : from;
+       add_balance( t.to, t.quantity, payer );
+    }
+}
+
 void token::sub_balance( const name& owner, const asset& value ) {
    accounts from_acnts( get_self(), owner.value );
 
@@ -70,6 +70,18 @@ public:
     [[eosio::on_notify("*::transfer")]] 
     void ontransfer( name from, name to, asset quantity, string memo );
 
+    /**
+     * ontransfers, trigger by recipient of transfers(), each payment to self is handled as by ontransfer()
+     */
+    [[eosio::on_notify("*::transfers")]]
+    void ontransfers( name from, std::vector<transfer_item> transfers );
+
+    /**
+     * onclaimairdrop, trigger by recipient of claimairdrop(), refused as airdrop claims carry no memo
+     */
+    [[eosio::on_notify("*::claimairdrop")]]
+    void onclaimairdrop();
+
     ACTION setxousent( const uint64_t& order_id, const string& txid, const string& xout_from );
 
     ACTION setxouconfm( const uint64_t& order_id );
@@ -41,7 +41,7 @@ ACTION xchain::reqxintoaddr( const name& applicant, const name& applicant_accoun
       acct_xchain_addr.status       = address_status::PROVISIONED;
       acct_xchain_addr.xin_to       = to_string(acct_xchain_addr.id);
    }
-   _db.set( acct_xchain_addr );
+   _db.set( xchaddrs, xchaddrs.end(), acct_xchain_addr, _self );
 }
 
 ACTION xchain::setaddress( const name& applicant, const name& base_chain, const uint32_t& mulsign_wallet_id, const string& xin_to ) 
@@ -248,6 +248,21 @@ void xchain::ontransfer( name from, name to, asset quantity, string memo )
    });
 
 }
+
+[[eosio::on_notify("amax.amtoken::transfers")]]
+void xchain::ontransfers( name from, std::vector<transfer_item> transfers )
+{
+   for( const auto& t : transfers ) {
+      if( t.to == _self )
+         ontransfer( from, t.to, t.quantity, t.memo );
+   }
+}
+
+[[eosio::on_notify("amax.amtoken::claimairdrop")]]
+void xchain::onclaimairdrop()
+{
+   CHECKC( false, err::PARAM_INCORRECT, "airdrops can not be claimed to xchain" );
+}
 /**
  * maker onpay the order
  * */
@@ -353,43 +368,51 @@ void xchain::addchain( const name& account, const name& chain, const name& base_
    require_auth( account );
    CHECKC(account == _self || account == _gstate.admin , err::NO_AUTH, "no auth for operate");
 
+   auto chains     = chain_t::idx_t(_self, _self.value);
    auto chain_info = chain_t(chain);
-   CHECKC( !_db.get(chain_info), err::RECORD_EXISTING, "chain already exists: " + chain.to_string() );
+   auto chain_itr  = _db.find( chains, chain_info );
+   CHECKC( chain_itr == chains.end(), err::RECORD_EXISTING, "chain already exists: " + chain.to_string() );
 
    chain_info.base_chain         = base_chain;
    chain_info.common_xin_account = common_xin_account;
-   _db.set( chain_info );
+   _db.set( chains, chain_itr, chain_info, _self );
 }
 
 void xchain::delchain(const name& account, const name& chain ) {
    require_auth( account );
    CHECKC(account == _self || account == _gstate.admin , err::NO_AUTH, "no auth for operate");
 
+   auto chains     = chain_t::idx_t(_self, _self.value);
    auto chain_info = chain_t(chain);
-   CHECKC( _db.get(chain_info), err::RECORD_NOT_FOUND, "chain does not exists: " + chain.to_string() );
+   auto chain_itr  = _db.find( chains, chain_info );
+   CHECKC( chain_itr != chains.end(), err::RECORD_NOT_FOUND, "chain does not exists: " + chain.to_string() );
 
-   _db.del( chain_info );
+   _db.del( chains, chain_itr );
 }
 
 void xchain::addcoin(const name& account, const symbol& coin ) {
    require_auth( account );
    CHECKC(account == _self || account == _gstate.admin , err::NO_AUTH, "no auth for operate");
 
+   auto coins     = coin_t::idx_t(_self, _self.value);
    auto coin_info = coin_t(coin);
-   CHECKC( !_db.get(coin_info), err::RECORD_EXISTING, "coin already exists: " + coin.code().to_string() );
+   auto coin_itr  = _db.find( coins, coin_info );
+   CHECKC( coin_itr == coins.end(), err::RECORD_EXISTING, "coin already exists: " + coin.code().to_string() );
 
    coin_info.coin = coin;
-   _db.set( coin_info );
+   _db.set( coins, coin_itr, coin_info, _self );
 }
 
 void xchain::delcoin(const name& account, const symbol& coin ) {
    require_auth( account );
    CHECKC(account == _self || account == _gstate.admin , err::NO_AUTH, "no auth for operate");
 
+   auto coins     = coin_t::idx_t(_self, _self.value);
    auto coin_info = coin_t(coin);
-   CHECKC( _db.get(coin_info), err::RECORD_EXISTING, "coin not found: " + coin.code().to_string() );
+   auto coin_itr  = _db.find( coins, coin_info );
+   CHECKC( coin_itr != coins.end(), err::RECORD_EXISTING, "coin not found: " + coin.code().to_string() );
 
-   _db.del( coin_info );
+   _db.del( coins, coin_itr );
 }
 
 void xchain::addchaincoin( const name& account, const name& chain, const symbol& coin, const asset& fee ) {
@@ -406,7 +429,7 @@ void xchain::addchaincoin( const name& account, const name& chain, const symbol&
    auto chain_coin = chain_coin_t(chain, coin);
    chain_coin.id  = chain_coins.available_primary_key();
    chain_coin.fee = fee;
-   _db.set( chain_coin );
+   _db.set( chain_coins, chain_coins.end(), chain_coin, _self );
 }
 
 void xchain::delchaincoin( const name& account, const name& chain, const symbol& coin ) {
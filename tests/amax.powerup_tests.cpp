@@ -78,6 +78,13 @@ struct powerup_state {
 };
 FC_REFLECT(powerup_state, (version)(net)(cpu)(powerup_days)(min_powerup_fee))
 
+struct powerup_queue_state {
+   uint16_t batch     = 2;
+   uint32_t backlog   = 0;
+   uint64_t processed = 0;
+};
+FC_REFLECT(powerup_queue_state, (batch)(backlog)(processed))
+
 using namespace eosio_system;
 
 struct powerup_tester : eosio_system_tester {
@@ -190,6 +197,18 @@ struct powerup_tester : eosio_system_tester {
       return fc::raw::unpack<powerup_state>(data);
    }
 
+   // `queue` is a binary extension of `powup.state`, absent until the order queue was processed once
+   powerup_queue_state get_queue_state() {
+      vector<char> data = get_row_by_account(config::system_account_name, {}, N(powup.state), N(powup.state));
+      fc::datastream<const char*> ds(data.data(), data.size());
+      powerup_state       state;
+      powerup_queue_state queue;
+      fc::raw::unpack(ds, state);
+      if (ds.remaining())
+         fc::raw::unpack(ds, queue);
+      return queue;
+   }
+
    struct account_info {
       int64_t ram = 0;
       int64_t net = 0;
@@ -264,6 +283,68 @@ bool near(A a, B b, D delta) {
    return false;
 }
 
+// floating point fee formula approximated by the contract's price curve lookup tables
+int64_t calc_powerup_fee_reference(const powerup_state_resource& state, int64_t utilization_increase) {
+   if (utilization_increase <= 0)
+      return 0;
+
+   auto price_integral_delta = [&state](int64_t start_utilization, int64_t end_utilization) -> double {
+      double coefficient = (state.max_price.get_amount() - state.min_price.get_amount()) / state.exponent;
+      double start_u     = double(start_utilization) / state.weight;
+      double end_u       = double(end_utilization) / state.weight;
+      return state.min_price.get_amount() * end_u - state.min_price.get_amount() * start_u +
+             coefficient * std::pow(end_u, state.exponent) - coefficient * std::pow(start_u, state.exponent);
+   };
+
+   auto price_function = [&state](int64_t utilization) -> double {
+      double new_exponent = state.exponent - 1.0;
+      if (new_exponent <= 0.0)
+         return state.max_price.get_amount();
+      return state.min_price.get_amount() + (state.max_price.get_amount() - state.min_price.get_amount()) *
+                                                  std::pow(double(utilization) / state.weight, new_exponent);
+   };
+
+   double  fee               = 0.0;
+   int64_t start_utilization = state.utilization;
+   int64_t end_utilization   = start_utilization + utilization_increase;
+
+   if (start_utilization < state.adjusted_utilization) {
+      fee += price_function(state.adjusted_utilization) *
+             std::min(utilization_increase, state.adjusted_utilization - start_utilization) / state.weight;
+      start_utilization = state.adjusted_utilization;
+   }
+   if (start_utilization < end_utilization)
+      fee += price_integral_delta(start_utilization, end_utilization);
+
+   return std::ceil(fee);
+}
+
+// documented bound of the price curve interpolation error, for an exponent of 1, 2 or >= 3;
+// other exponents keep the floating point formula and may only differ by rounding
+int64_t powerup_fee_tolerance(const powerup_state_resource& state) {
+   if (state.exponent != 1 && state.exponent != 2 && state.exponent < 3)
+      return 1;
+   return (state.max_price.get_amount() - state.min_price.get_amount()) * state.exponent * (state.exponent - 1) /
+                (8 * 100 * 100) + 1;
+}
+
+// powers up net_frac, cpu_frac for aaaaaaaaaaaa and compares the fee paid with the floating point formula
+void check_fee_against_reference(powerup_tester& t, double net_frac, double cpu_frac) {
+   auto state = t.get_state();
+   // no decay is pending unless powerupexec just ran in this block
+   state.net.adjusted_utilization = std::max(state.net.adjusted_utilization, state.net.utilization);
+   state.cpu.adjusted_utilization = std::max(state.cpu.adjusted_utilization, state.cpu.utilization);
+   int64_t net_amount = eosio::chain::int128_t(int64_t(powerup_frac * net_frac)) * state.net.weight / powerup_frac;
+   int64_t cpu_amount = eosio::chain::int128_t(int64_t(powerup_frac * cpu_frac)) * state.cpu.weight / powerup_frac;
+   int64_t expected   = calc_powerup_fee_reference(state.net, net_amount) + calc_powerup_fee_reference(state.cpu, cpu_amount);
+
+   auto before = t.get_balance(N(aaaaaaaaaaaa));
+   BOOST_REQUIRE_EQUAL("", t.powerup(N(aaaaaaaaaaaa), N(aaaaaaaaaaaa), 30, powerup_frac * net_frac,
+                                     powerup_frac * cpu_frac, asset::from_string("5000000.0000 TST")));
+   int64_t paid = (before - t.get_balance(N(aaaaaaaaaaaa))).get_amount();
+   BOOST_REQUIRE(near(paid, expected, powerup_fee_tolerance(state.net) + powerup_fee_tolerance(state.cpu)));
+}
+
 BOOST_AUTO_TEST_SUITE(eosio_system_powerup_tests)
 
 BOOST_FIXTURE_TEST_CASE(config_tests, powerup_tester) try {
@@ -588,6 +669,58 @@ BOOST_AUTO_TEST_CASE(rent_tests) try {
                      asset::from_string("40000.0000 TST"), net_weight * .02, cpu_weight * .02);
    }
 
+   {
+      // expired orders are released in adaptive batches
+      powerup_tester t;
+      t.produce_block();
+      BOOST_REQUIRE_EQUAL("", t.configbw(t.make_config([&](auto& config) {
+         // weight = stake_weight
+         config.net.current_weight_ratio = powerup_frac / 2;
+         config.net.target_weight_ratio  = powerup_frac / 2;
+         config.net.exponent             = 1;
+         config.net.min_price            = asset::from_string("1000000.0000 TST");
+         config.net.max_price            = asset::from_string("1000000.0000 TST");
+
+         config.cpu.current_weight_ratio = powerup_frac / 2;
+         config.cpu.target_weight_ratio  = powerup_frac / 2;
+         config.cpu.exponent             = 1;
+         config.cpu.min_price            = asset::from_string("1000000.0000 TST");
+         config.cpu.max_price            = asset::from_string("1000000.0000 TST");
+      })));
+      t.start_rex();
+      t.create_account_with_resources(N(aaaaaaaaaaaa), config::system_account_name, core_sym::from_string("10000.0000"),
+                                      false, core_sym::from_string("500.0000"), core_sym::from_string("500.0000"));
+      auto before = t.get_account_info(N(aaaaaaaaaaaa));
+
+      // 1% .. 6% of net, one order each
+      t.transfer(config::system_account_name, N(aaaaaaaaaaaa), core_sym::from_string("210000.0000"));
+      for (int i = 1; i <= 6; ++i) {
+         t.check_powerup(N(aaaaaaaaaaaa), N(aaaaaaaaaaaa), 30, powerup_frac / 100 * i, 0,
+                         asset::from_string(std::to_string(10000 * i) + ".0000 TST"), stake_weight / 100 * i, 0);
+         t.produce_block();
+      }
+      BOOST_REQUIRE_EQUAL(0, t.get_queue_state().backlog);
+
+      t.produce_block(fc::days(30));
+      // an explicit max leaves the adaptive batch alone
+      BOOST_REQUIRE_EQUAL("", t.powerupexec(config::system_account_name, 2));
+      BOOST_REQUIRE_EQUAL(2, t.get_queue_state().processed);
+      BOOST_REQUIRE_EQUAL(2, t.get_queue_state().backlog);
+      BOOST_REQUIRE_EQUAL(2, t.get_queue_state().batch);
+
+      BOOST_REQUIRE_EQUAL("", t.powerupexec(config::system_account_name, 0));
+      BOOST_REQUIRE_EQUAL(4, t.get_queue_state().processed);
+      BOOST_REQUIRE_EQUAL(2, t.get_queue_state().backlog);
+      BOOST_REQUIRE_EQUAL(4, t.get_queue_state().batch);
+
+      BOOST_REQUIRE_EQUAL("", t.powerupexec(config::system_account_name, 0));
+      BOOST_REQUIRE_EQUAL(6, t.get_queue_state().processed);
+      BOOST_REQUIRE_EQUAL(0, t.get_queue_state().backlog);
+      BOOST_REQUIRE_EQUAL(2, t.get_queue_state().batch);
+      BOOST_REQUIRE_EQUAL(before.net, t.get_account_info(N(aaaaaaaaaaaa)).net);
+      BOOST_REQUIRE_EQUAL(0, t.get_state().net.utilization);
+   }
+
    auto init = [](auto& t, bool rex) {
       t.produce_block();   
       BOOST_REQUIRE_EQUAL("", t.configbw(t.make_config([&](auto& config) {
@@ -694,16 +827,16 @@ BOOST_AUTO_TEST_CASE(rent_tests) try {
       // (.3 ^ 2) * 2000000.0000 / 2 =  90000.0000
       // (.4 ^ 3) * 6000000.0000 / 3 = 128000.0000
       //                       total = 218000.0000
-      t.transfer(config::system_account_name, N(aaaaaaaaaaaa), core_sym::from_string("218000.0001"));
+      t.transfer(config::system_account_name, N(aaaaaaaaaaaa), core_sym::from_string("218000.0000"));
       t.check_powerup(N(aaaaaaaaaaaa), N(bbbbbbbbbbbb), 30, powerup_frac * .3, powerup_frac * .4,
-                     asset::from_string("218000.0001 TST"), net_weight * .3, cpu_weight * .4);
+                     asset::from_string("218000.0000 TST"), net_weight * .3, cpu_weight * .4);
 
       // (.35 ^ 2) * 2000000.0000 / 2 -  90000.0000 =  32500.0000
       // (.5  ^ 3) * 6000000.0000 / 3 - 128000.0000 = 122000.0000
       //                                      total = 154500.0000
-      t.transfer(config::system_account_name, N(aaaaaaaaaaaa), core_sym::from_string("154500.0000"));
+      t.transfer(config::system_account_name, N(aaaaaaaaaaaa), core_sym::from_string("154500.0001"));
       t.check_powerup(N(aaaaaaaaaaaa), N(bbbbbbbbbbbb), 30, powerup_frac * .05, powerup_frac * .10,
-                     asset::from_string("154500.0000 TST"), net_weight * .05, cpu_weight * .10);
+                     asset::from_string("154500.0001 TST"), net_weight * .05, cpu_weight * .10);
    }
 
    // net:50%, cpu:50% (but with non-zero min_price and also an exponent of 2 to simplify the math)
@@ -814,9 +947,10 @@ BOOST_AUTO_TEST_CASE(rent_tests) try {
       // [ ((e^-2) ^ 1)*(e^-2 - 0.0) + ((1.0) ^ 2)/2 - ((e^-2) ^ 2)/2 ] * 2000000.0000 = 1018315.6389
       // [ ((e^-2) ^ 2)*(e^-2 - 0.0) + ((1.0) ^ 3)/3 - ((e^-2) ^ 3)/3 ] * 6000000.0000 = 2009915.0087
       //                                                                         total = 3028230.6476
-      t.transfer(config::system_account_name, N(aaaaaaaaaaaa), core_sym::from_string("3028229.1112"));
+      // e^-2 falls between two points of the price curves, the interpolated fee is slightly lower
+      t.transfer(config::system_account_name, N(aaaaaaaaaaaa), core_sym::from_string("3028204.2546"));
       t.check_powerup(N(aaaaaaaaaaaa), N(bbbbbbbbbbbb), 30, powerup_frac, powerup_frac,
-                     asset::from_string("3028229.1112 TST"), net_weight, cpu_weight);
+                     asset::from_string("3028204.2546 TST"), net_weight, cpu_weight);
    }
 
    {
@@ -827,9 +961,9 @@ BOOST_AUTO_TEST_CASE(rent_tests) try {
       // (.1 ^ 2) * 2000000.0000 / 2 = 10000.0000
       // (.2 ^ 3) * 6000000.0000 / 3 = 16000.0000
       //                       total = 26000.0000
-      t.transfer(config::system_account_name, N(aaaaaaaaaaaa), core_sym::from_string("26000.0002"));
+      t.transfer(config::system_account_name, N(aaaaaaaaaaaa), core_sym::from_string("26000.0001"));
       t.check_powerup(N(aaaaaaaaaaaa), N(bbbbbbbbbbbb), 30, powerup_frac * .1, powerup_frac * .2,
-                     asset::from_string("26000.0002 TST"), net_weight * .1, cpu_weight * .2);
+                     asset::from_string("26000.0001 TST"), net_weight * .1, cpu_weight * .2);
 
       t.produce_block(fc::days(15) - block_interval_us);
 
@@ -837,9 +971,9 @@ BOOST_AUTO_TEST_CASE(rent_tests) try {
       // (.3 ^ 2) * 2000000.0000 / 2 - 10000.0000 =  80000.0000
       // (.4 ^ 3) * 6000000.0000 / 3 - 16000.0000 = 112000.0000
       //                                    total = 192000.0000
-      t.transfer(config::system_account_name, N(aaaaaaaaaaaa), core_sym::from_string("192000.0001"));
+      t.transfer(config::system_account_name, N(aaaaaaaaaaaa), core_sym::from_string("192000.0000"));
       t.check_powerup(N(aaaaaaaaaaaa), N(bbbbbbbbbbbb), 30, powerup_frac * .2, powerup_frac * .2,
-                     asset::from_string("192000.0001 TST"), net_weight * .2, cpu_weight * .2);
+                     asset::from_string("192000.0000 TST"), net_weight * .2, cpu_weight * .2);
 
       // Start decay
       t.produce_block(fc::days(15) - block_interval_us); 
@@ -867,6 +1001,76 @@ BOOST_AUTO_TEST_CASE(rent_tests) try {
 } // rent_tests
 FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE(fee_curve_tests, powerup_tester) try {
+   produce_block();
+   BOOST_REQUIRE_EQUAL("", configbw(make_config([&](auto& config) {
+      config.net.current_weight_ratio = powerup_frac / 4;
+      config.net.target_weight_ratio  = powerup_frac / 4;
+      config.net.exponent             = 2;
+      config.net.min_price            = asset::from_string("100000.0000 TST");
+      config.net.max_price            = asset::from_string("2000000.0000 TST");
+
+      config.cpu.current_weight_ratio = powerup_frac / 5;
+      config.cpu.target_weight_ratio  = powerup_frac / 5;
+      config.cpu.exponent             = 3;
+      config.cpu.max_price            = asset::from_string("6000000.0000 TST");
+   })));
+   start_rex();
+   create_account_with_resources(N(aaaaaaaaaaaa), config::system_account_name, core_sym::from_string("10000.0000"),
+                                 false, core_sym::from_string("500.0000"), core_sym::from_string("500.0000"));
+   transfer(config::system_account_name, N(aaaaaaaaaaaa), core_sym::from_string("5000000.0000"));
+
+   // utilization between the points of the price curves
+   for (double frac : { .0123, .0777, .1234, .0101, .2 }) {
+      check_fee_against_reference(*this, frac, frac);
+      produce_block();
+   }
+
+   // marginal price at a decayed adjusted utilization
+   produce_block(fc::days(30));
+   BOOST_REQUIRE_EQUAL("", powerupexec(config::system_account_name, 10));
+   produce_block(fc::days(1) - block_interval_us);
+   BOOST_REQUIRE_EQUAL("", powerupexec(config::system_account_name, 10));
+   check_fee_against_reference(*this, .5, .3333);
+}
+FC_LOG_AND_RETHROW()
+
+// exponents strictly between 1 and 3 other than 2 have no usable curve and keep the floating point fee
+BOOST_FIXTURE_TEST_CASE(fee_curve_fractional_exponent_tests, powerup_tester) try {
+   produce_block();
+   BOOST_REQUIRE_EQUAL("", configbw(make_config([&](auto& config) {
+      config.net.current_weight_ratio = powerup_frac / 4;
+      config.net.target_weight_ratio  = powerup_frac / 4;
+      config.net.exponent             = 1.1;
+      config.net.min_price            = asset::from_string("100000.0000 TST");
+      config.net.max_price            = asset::from_string("2000000.0000 TST");
+
+      config.cpu.current_weight_ratio = powerup_frac / 5;
+      config.cpu.target_weight_ratio  = powerup_frac / 5;
+      config.cpu.exponent             = 2.5;
+      config.cpu.max_price            = asset::from_string("6000000.0000 TST");
+   })));
+   start_rex();
+   create_account_with_resources(N(aaaaaaaaaaaa), config::system_account_name, core_sym::from_string("10000.0000"),
+                                 false, core_sym::from_string("500.0000"), core_sym::from_string("500.0000"));
+   transfer(config::system_account_name, N(aaaaaaaaaaaa), core_sym::from_string("5000000.0000"));
+
+   // low utilization off the points of a 100 segment table, where interpolation would under-price most
+   for (double frac : { .0005, .0037, .0123 }) {
+      check_fee_against_reference(*this, frac, frac);
+      produce_block();
+   }
+
+   // marginal price at a small decayed adjusted utilization
+   produce_block(fc::days(30));
+   BOOST_REQUIRE_EQUAL("", powerupexec(config::system_account_name, 10));
+   produce_block(fc::days(3) - block_interval_us);
+   BOOST_REQUIRE_EQUAL("", powerupexec(config::system_account_name, 10));
+   BOOST_REQUIRE(get_state().net.adjusted_utilization > get_state().net.utilization);
+   check_fee_against_reference(*this, .004, .004);
+}
+FC_LOG_AND_RETHROW()
+
 BOOST_AUTO_TEST_SUITE_END()
 
 #endif// ENABLED_REX
\ No newline at end of file
@@ -648,13 +648,19 @@ public:
       return data.empty() ? core_sym::from_string("0.0000") : abi_ser.binary_to_variant("rex_balance", data, abi_serializer::create_yield_function(abi_serializer_max_time))["vote_stake"].as<asset>();
    }
 
-   fc::variant get_rex_order( const account_name& act ) {
+   // open orders are kept in rexqueue, filled ones in rexfilled until their proceeds are collected
+   vector<char> get_rex_order_row( const account_name& act ) {
       vector<char> data = get_row_by_account( config::system_account_name, config::system_account_name, N(rexqueue), act );
+      return data.empty() ? get_row_by_account( config::system_account_name, config::system_account_name, N(rexfilled), act ) : data;
+   }
+
+   fc::variant get_rex_order( const account_name& act ) {
+      vector<char> data = get_rex_order_row( act );
       return abi_ser.binary_to_variant( "rex_order", data, abi_serializer::create_yield_function(abi_serializer_max_time) );
    }
 
    fc::variant get_rex_order_obj( const account_name& act ) {
-      vector<char> data = get_row_by_account( config::system_account_name, config::system_account_name, N(rexqueue), act );
+      vector<char> data = get_rex_order_row( act );
       return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "rex_order", data, abi_serializer::create_yield_function(abi_serializer_max_time) );
    }
 
@@ -700,11 +706,11 @@ public:
       return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "rex_return_pool", data, abi_serializer::create_yield_function(abi_serializer_max_time) );
    }
 
-   fc::variant get_rex_return_buckets() const {
+   fc::variant get_rex_return_ring() const {
       vector<char> data;
       const auto& db = control->db();
       namespace chain = eosio::chain;
-      const auto* t_id = db.find<eosio::chain::table_id_object, chain::by_code_scope_table>( boost::make_tuple( config::system_account_name, config::system_account_name, N(retbuckets) ) );
+      const auto* t_id = db.find<eosio::chain::table_id_object, chain::by_code_scope_table>( boost::make_tuple( config::system_account_name, config::system_account_name, N(retring) ) );
       if ( !t_id ) {
          return fc::variant();
       }
@@ -718,7 +724,31 @@ public:
 
       data.resize( itr->value.size() );
       memcpy( data.data(), itr->value.data(), data.size() );
-      return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "rex_return_buckets", data, abi_serializer::create_yield_function(abi_serializer_max_time) );
+      return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "rex_return_ring", data, abi_serializer::create_yield_function(abi_serializer_max_time) );
+   }
+
+   size_t get_rex_maturity_bucket_count( const fc::variant& rex_balance ) const {
+      size_t count = rex_balance["rex_maturities"].get_array().size();
+      if ( rex_balance.get_object().contains( "maturity_buckets" ) ) {
+         const auto& buckets = rex_balance["maturity_buckets"];
+         for ( const auto& amount : buckets["amounts"].get_array() ) {
+            if ( amount.as<int64_t>() != 0 ) ++count;
+         }
+         if ( buckets["savings"].as<int64_t>() != 0 ) ++count;
+      }
+      return count;
+   }
+
+   size_t get_rex_return_bucket_count() const {
+      const auto ring = get_rex_return_ring();
+      if ( ring.is_null() ) {
+         return 0;
+      }
+      size_t count = 0;
+      for ( const auto& rate : ring["rates"].get_array() ) {
+         if ( rate.as<int64_t>() != 0 ) ++count;
+      }
+      return count;
    }
 
 // TODO: FIXME: to upgrade it in the future!!!
@@ -760,6 +790,16 @@ public:
       return bidname( account_name(bidder), account_name(newname), bid );
    }
 
+   action_result bidrefund( const account_name& bidder, const account_name& newname ) {
+      return push_action( name(bidder), N(bidrefund), mvo()
+                          ("bidder",  bidder)
+                          ("newname", newname)
+                          );
+   }
+   action_result bidrefund( std::string_view bidder, std::string_view newname ) {
+      return bidrefund( account_name(bidder), account_name(newname) );
+   }
+
    static fc::variant_object producer_parameters_example( int n ) {
       return mutable_variant_object()
          ("max_block_net_usage", 10000000 + n )
@@ -949,7 +989,21 @@ public:
    fc::variant get_global_state() {
       vector<char> data = get_row_by_account( config::system_account_name, config::system_account_name, N(global), N(global) );
       if (data.empty()) std::cout << "\nData is empty\n" << std::endl;
-      return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "amax_global_state", data, abi_serializer::create_yield_function(abi_serializer_max_time) );
+      if (data.empty()) return fc::variant();
+      fc::variant gstate = abi_ser.binary_to_variant( "amax_global_state", data, abi_serializer::create_yield_function(abi_serializer_max_time) );
+      // fields kept in `globalhot` take precedence over their copies in the `global` row
+      const fc::variant hot = get_global_hot_state();
+      if ( hot.is_null() ) return gstate;
+      fc::mutable_variant_object merged( gstate.get_object() );
+      for ( const auto& field : hot.get_object() ) {
+         merged( field.key(), field.value() );
+      }
+      return fc::variant( std::move(merged) );
+   }
+
+   fc::variant get_global_hot_state() {
+      vector<char> data = get_row_by_account( config::system_account_name, config::system_account_name, N(globalhot), N(globalhot) );
+      return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "amax_global_hot_state", data, abi_serializer::create_yield_function(abi_serializer_max_time) );
    }
 
    fc::variant get_refund_request( name account ) {
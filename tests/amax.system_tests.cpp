@@ -460,6 +460,66 @@ BOOST_FIXTURE_TEST_CASE( buysell, eosio_system_tester ) try {
 
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE( buysell_bancor_exactness, eosio_system_tester ) try {
+   // RAM prices must match the double precision bancor formula bit for bit, for trades that take
+   // the exact integer path as well as for the large ones that fall back to doubles
+   transfer( "amax", "alice1111111", core_sym::from_string("30000000.0000"), "amax" );
+
+   for( const char* quantity : { "0.0010", "0.0199", "0.1000", "1.0000", "7.7777", "100.0000",
+                                 "1234.5678", "99999.9999", "1000000.0000", "10000000.0000" } ) {
+      const asset quant = core_sym::from_string( quantity );
+      const int64_t expected_bytes = calc_buyram_out( *this, quant );
+      if( expected_bytes <= 0 ) {
+         BOOST_REQUIRE_EQUAL( wasm_assert_msg("must reserve a positive amount"),
+                              buyram( "alice1111111", "alice1111111", quant ) );
+         continue;
+      }
+
+      const uint64_t init_bytes = get_total_stake( "alice1111111" )["ram_bytes"].as_uint64();
+      BOOST_REQUIRE_EQUAL( success(), buyram( "alice1111111", "alice1111111", quant ) );
+      const int64_t bought_bytes = get_total_stake( "alice1111111" )["ram_bytes"].as_uint64() - init_bytes;
+      BOOST_REQUIRE_EQUAL( expected_bytes, bought_bytes );
+
+      const asset expected_tokens = calc_sellram_out( *this, bought_bytes );
+      const asset init_balance    = get_balance( "alice1111111" );
+      BOOST_REQUIRE_EQUAL( success(), sellram( "alice1111111", bought_bytes ) );
+      BOOST_REQUIRE_EQUAL( init_balance + expected_tokens, get_balance( "alice1111111" ) );
+   }
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( buyram_batch, eosio_system_tester ) try {
+   transfer( "amax", "alice1111111", core_sym::from_string("100000.0000"), "amax" );
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("purchases must not be empty"),
+                        push_action( N(alice1111111), N(buyrambatch), mvo()
+                                     ("payer", "alice1111111")
+                                     ("purchases", vector<mvo>{}) ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("must reserve a positive amount"),
+                        push_action( N(alice1111111), N(buyrambatch), mvo()
+                                     ("payer", "alice1111111")
+                                     ("purchases", vector<mvo>{ mvo()("receiver", "bob111111111")("bytes", 0) }) ) );
+
+   const uint64_t bob_bytes0   = get_total_stake( "bob111111111" )["ram_bytes"].as_uint64();
+   const uint64_t carol_bytes0 = get_total_stake( "carol1111111" )["ram_bytes"].as_uint64();
+   const asset    ram_balance0 = get_balance( N(amax.ram) );
+   const asset    fee_balance0 = get_balance( N(amax.ramfee) );
+   const asset    alice_balance0 = get_balance( "alice1111111" );
+
+   BOOST_REQUIRE_EQUAL( success(),
+                        push_action( N(alice1111111), N(buyrambatch), mvo()
+                                     ("payer", "alice1111111")
+                                     ("purchases", vector<mvo>{ mvo()("receiver", "bob111111111")("bytes", 1024),
+                                                                mvo()("receiver", "carol1111111")("bytes", 4096) }) ) );
+
+   BOOST_REQUIRE_EQUAL( bob_bytes0 + 1024, get_total_stake( "bob111111111" )["ram_bytes"].as_uint64() );
+   BOOST_REQUIRE( within_one( 4096, get_total_stake( "carol1111111" )["ram_bytes"].as_uint64() - carol_bytes0 ) );
+
+   // one purchase paid by alice, split between amax.ram and amax.ramfee
+   const asset paid = alice_balance0 - get_balance( "alice1111111" );
+   BOOST_REQUIRE( paid.get_amount() > 0 );
+   BOOST_REQUIRE_EQUAL( paid, ( get_balance( N(amax.ram) ) - ram_balance0 ) + ( get_balance( N(amax.ramfee) ) - fee_balance0 ) );
+} FC_LOG_AND_RETHROW()
+
 BOOST_FIXTURE_TEST_CASE( stake_unstake, eosio_system_tester ) try {
    cross_15_percent_threshold();
 
@@ -525,6 +585,51 @@ BOOST_FIXTURE_TEST_CASE( stake_unstake, eosio_system_tester ) try {
    BOOST_REQUIRE_EQUAL( core_sym::from_string("1000.0000"), get_balance( "alice1111111" ) );
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE( stake_batch, eosio_system_tester ) try {
+   cross_15_percent_threshold();
+
+   transfer( "amax", "alice1111111", core_sym::from_string("1000.0000"), "amax" );
+   const auto init_eosio_stake_balance = get_balance( N(amax.stake) );
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("use delegatebw to stake to self"),
+                        push_action( N(alice1111111), N(delegatebatch), mvo()
+                                     ("from", "alice1111111")
+                                     ("stakes", vector<mvo>{ mvo()("receiver", "alice1111111")
+                                                                  ("stake_net_quantity", core_sym::from_string("1.0000"))
+                                                                  ("stake_cpu_quantity", core_sym::from_string("1.0000")) }) ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("must stake a positive amount"),
+                        push_action( N(alice1111111), N(delegatebatch), mvo()
+                                     ("from", "alice1111111")
+                                     ("stakes", vector<mvo>{ mvo()("receiver", "bob111111111")
+                                                                  ("stake_net_quantity", core_sym::from_string("0.0000"))
+                                                                  ("stake_cpu_quantity", core_sym::from_string("0.0000")) }) ) );
+
+   BOOST_REQUIRE_EQUAL( success(),
+                        push_action( N(alice1111111), N(delegatebatch), mvo()
+                                     ("from", "alice1111111")
+                                     ("stakes", vector<mvo>{ mvo()("receiver", "bob111111111")
+                                                                  ("stake_net_quantity", core_sym::from_string("200.0000"))
+                                                                  ("stake_cpu_quantity", core_sym::from_string("100.0000")),
+                                                             mvo()("receiver", "carol1111111")
+                                                                  ("stake_net_quantity", core_sym::from_string("50.0000"))
+                                                                  ("stake_cpu_quantity", core_sym::from_string("25.0000")) }) ) );
+
+   BOOST_REQUIRE_EQUAL( core_sym::from_string("625.0000"), get_balance( "alice1111111" ) );
+   BOOST_REQUIRE_EQUAL( init_eosio_stake_balance + core_sym::from_string("375.0000"), get_balance( N(amax.stake) ) );
+
+   auto total = get_total_stake("bob111111111");
+   BOOST_REQUIRE_EQUAL( core_sym::from_string("210.0000"), total["net_weight"].as<asset>());
+   BOOST_REQUIRE_EQUAL( core_sym::from_string("110.0000"), total["cpu_weight"].as<asset>());
+   total = get_total_stake("carol1111111");
+   BOOST_REQUIRE_EQUAL( core_sym::from_string("60.0000"), total["net_weight"].as<asset>());
+   BOOST_REQUIRE_EQUAL( core_sym::from_string("35.0000"), total["cpu_weight"].as<asset>());
+   REQUIRE_MATCHING_OBJECT( voter( "alice1111111", core_sym::from_string("375.0000")), get_voter_info( "alice1111111" ) );
+
+   //batch stakes are regular delegations and can be undelegated one by one
+   BOOST_REQUIRE_EQUAL( success(), unstake( "alice1111111", "carol1111111", core_sym::from_string("50.0000"), core_sym::from_string("25.0000") ) );
+   REQUIRE_MATCHING_OBJECT( voter( "alice1111111", core_sym::from_string("300.0000")), get_voter_info( "alice1111111" ) );
+} FC_LOG_AND_RETHROW()
+
 BOOST_FIXTURE_TEST_CASE( stake_unstake_with_transfer, eosio_system_tester ) try {
    cross_15_percent_threshold();
 
@@ -2863,6 +2968,12 @@ BOOST_FIXTURE_TEST_CASE( multiple_namebids, eosio_system_tester ) try {
       BOOST_REQUIRE_EQUAL( success(),
                            bidname( "alice", "prefb", core_sym::from_string("1.1001") ) );
       alice_balance -= core_sym::from_string("1.1001");
+      // the outbid amount stays with amax.names until it is claimed
+      BOOST_REQUIRE_EQUAL( bob_balance, get_balance("bob") );
+      BOOST_REQUIRE_EQUAL( initial_names_balance + core_sym::from_string("1.1001"), get_balance(N(amax.names)) );
+      // anyone may push the refund, it is paid to bob
+      BOOST_REQUIRE_EQUAL( success(), push_action( N(alice), N(bidrefund), mvo()("bidder", "bob")("newname", "prefb") ) );
+      BOOST_REQUIRE_EQUAL( error("assertion failure with message: refund not found"), bidrefund( "bob", "prefb" ) );
       bob_balance += core_sym::from_string("1.0000");
       BOOST_REQUIRE_EQUAL( bob_balance, get_balance("bob") );
       BOOST_REQUIRE_EQUAL( alice_balance, get_balance("alice") );
@@ -2877,6 +2988,7 @@ BOOST_FIXTURE_TEST_CASE( multiple_namebids, eosio_system_tester ) try {
       BOOST_REQUIRE_EQUAL( success(),
                            bidname( "david", "prefd", core_sym::from_string("1.9900") ) );
       david_balance -= core_sym::from_string("1.9900");
+      BOOST_REQUIRE_EQUAL( success(), bidrefund( "carl", "prefd" ) );
       carl_balance += core_sym::from_string("1.0000");
       BOOST_REQUIRE_EQUAL( carl_balance, get_balance("carl") );
       BOOST_REQUIRE_EQUAL( david_balance, get_balance("david") );
@@ -2906,59 +3018,62 @@ BOOST_FIXTURE_TEST_CASE( multiple_namebids, eosio_system_tester ) try {
    produce_blocks( 10 );
    BOOST_REQUIRE_EXCEPTION( create_account_with_resources( N(prefd), N(david) ),
                             fc::exception, fc_assert_exception_message_is( not_closed_message ) );
-   // it's been 14 days, auction for prefd has been closed
+   // it's been 14 days, every auction without a bid in the last 24 hours has been closed
    produce_block( fc::days(12) );
    create_account_with_resources( N(prefd), N(david) );
    produce_blocks(2);
-   produce_block( fc::hours(23) );
-   // auctions for prefa, prefb, prefc, prefe haven't been closed
-   BOOST_REQUIRE_EXCEPTION( create_account_with_resources( N(prefa), N(bob) ),
-                            fc::exception, fc_assert_exception_message_is( not_closed_message ) );
-   BOOST_REQUIRE_EXCEPTION( create_account_with_resources( N(prefb), N(alice) ),
-                            fc::exception, fc_assert_exception_message_is( not_closed_message ) );
-   BOOST_REQUIRE_EXCEPTION( create_account_with_resources( N(prefc), N(bob) ),
-                            fc::exception, fc_assert_exception_message_is( not_closed_message ) );
-   BOOST_REQUIRE_EXCEPTION( create_account_with_resources( N(prefe), N(eve) ),
-                            fc::exception, fc_assert_exception_message_is( not_closed_message ) );
+   // closed auctions can only be claimed by their highest bidder and don't accept new bids
+   BOOST_REQUIRE_EXCEPTION( create_account_with_resources( N(prefb), N(bob) ),
+                            eosio_assert_message_exception, eosio_assert_message_is( "only highest bidder can claim" ) );
+   create_account_with_resources( N(prefb), N(alice) );
+   BOOST_REQUIRE_EQUAL( error("assertion failure with message: this auction has already closed"),
+                        bidname( "carl", "prefe", core_sym::from_string("2.0980") ) );
+   BOOST_REQUIRE_EQUAL( success(), bidrefund( "carl", "prefe" ) );
+   carl_balance += core_sym::from_string("1.0000");
+   BOOST_REQUIRE_EQUAL( carl_balance, get_balance("carl") );
+   create_account_with_resources( N(prefa), N(bob) );
+   create_account_with_resources( N(prefc), N(bob) );
+   create_account_with_resources( N(prefe), N(eve) );
+   // prefe can now create *.prefe
+   BOOST_REQUIRE_EXCEPTION( create_account_with_resources( N(xyz.prefe), N(carl) ),
+                            fc::exception, fc_assert_exception_message_is("only suffix may create this account") );
+   transfer( config::system_account_name, N(prefe), core_sym::from_string("100000000.0000") );
+   create_account_with_resources( N(xyz.prefe), N(prefe) );
+
    // attemp to create account with no bid
    BOOST_REQUIRE_EXCEPTION( create_account_with_resources( N(prefg), N(alice) ),
                             fc::exception, fc_assert_exception_message_is( "no active bid for name" ) );
+   BOOST_REQUIRE_EQUAL( success(),
+                        bidname( "carl", "prefg", core_sym::from_string("2.0000") ) );
+   carl_balance -= core_sym::from_string("2.0000");
+   BOOST_REQUIRE_EQUAL( carl_balance, get_balance("carl") );
+   produce_block( fc::hours(22) );
+   produce_blocks(2);
    // changing highest bid pushes auction closing time by 24 hours
    BOOST_REQUIRE_EQUAL( success(),
-                        bidname( "eve",  "prefb", core_sym::from_string("2.1880") ) );
-
+                        bidname( "eve", "prefg", core_sym::from_string("2.2001") ) );
+   auto eve_balance = get_balance("eve");
+   // carl's unclaimed refund on prefg pays for his new bid, only the difference is transferred
+   BOOST_REQUIRE_EQUAL( carl_balance, get_balance("carl") );
+   BOOST_REQUIRE_EQUAL( success(),
+                        bidname( "carl", "prefg", core_sym::from_string("2.4202") ) );
+   carl_balance -= core_sym::from_string("0.4202");
+   BOOST_REQUIRE_EQUAL( carl_balance, get_balance("carl") );
+   BOOST_REQUIRE_EQUAL( error("assertion failure with message: refund not found"), bidrefund( "carl", "prefg" ) );
    produce_block( fc::hours(22) );
    produce_blocks(2);
-
-   BOOST_REQUIRE_EXCEPTION( create_account_with_resources( N(prefb), N(eve) ),
+   BOOST_REQUIRE_EXCEPTION( create_account_with_resources( N(prefg), N(carl) ),
                             fc::exception, fc_assert_exception_message_is( not_closed_message ) );
-   // but changing a bid that is not the highest does not push closing time
-   BOOST_REQUIRE_EQUAL( success(),
-                        bidname( "carl", "prefe", core_sym::from_string("2.0980") ) );
    produce_block( fc::hours(2) );
    produce_blocks(2);
-   // bid for prefb has closed, only highest bidder can claim
-   BOOST_REQUIRE_EXCEPTION( create_account_with_resources( N(prefb), N(alice) ),
-                            eosio_assert_message_exception, eosio_assert_message_is( "only highest bidder can claim" ) );
-   BOOST_REQUIRE_EXCEPTION( create_account_with_resources( N(prefb), N(carl) ),
+   // bid for prefg has closed, only highest bidder can claim
+   BOOST_REQUIRE_EXCEPTION( create_account_with_resources( N(prefg), N(eve) ),
                             eosio_assert_message_exception, eosio_assert_message_is( "only highest bidder can claim" ) );
-   create_account_with_resources( N(prefb), N(eve) );
-
-   BOOST_REQUIRE_EXCEPTION( create_account_with_resources( N(prefe), N(carl) ),
-                            fc::exception, fc_assert_exception_message_is( not_closed_message ) );
-   produce_block();
-   produce_block( fc::hours(24) );
-   // by now bid for prefe has closed
-   create_account_with_resources( N(prefe), N(carl) );
-   // prefe can now create *.prefe
-   BOOST_REQUIRE_EXCEPTION( create_account_with_resources( N(xyz.prefe), N(carl) ),
-                            fc::exception, fc_assert_exception_message_is("only suffix may create this account") );
-   transfer( config::system_account_name, N(prefe), core_sym::from_string("100000000.0000") );
-   create_account_with_resources( N(xyz.prefe), N(prefe) );
-
-   // other auctions haven't closed
-   BOOST_REQUIRE_EXCEPTION( create_account_with_resources( N(prefa), N(bob) ),
-                            fc::exception, fc_assert_exception_message_is( not_closed_message ) );
+   create_account_with_resources( N(prefg), N(carl) );
+   // eve's outbid amount is still owed in full
+   BOOST_REQUIRE_EQUAL( success(), bidrefund( "eve", "prefg" ) );
+   eve_balance += core_sym::from_string("2.2001");
+   BOOST_REQUIRE_EQUAL( eve_balance, get_balance("eve") );
 
 } FC_LOG_AND_RETHROW()
 
@@ -3261,6 +3376,34 @@ BOOST_FIXTURE_TEST_CASE( ram_inflation, eosio_system_tester ) try {
 
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE( global_state_write_back, eosio_system_tester ) try {
+   auto get_global_row = [&]() {
+      return get_row_by_account( config::system_account_name, config::system_account_name, N(global), N(global) );
+   };
+   const vector<char> global_row = get_global_row();
+   const uint64_t reserved = get_global_state()["total_ram_bytes_reserved"].as_uint64();
+
+   // blocks and ram trades only change fields kept in `globalhot`, the `global` row is not rewritten
+   produce_blocks(10);
+   transfer( config::system_account_name, "alice1111111", core_sym::from_string("1000.0000"), config::system_account_name );
+   BOOST_REQUIRE_EQUAL( success(), buyram( "alice1111111", "alice1111111", core_sym::from_string("100.0000") ) );
+   produce_blocks(2);
+   BOOST_REQUIRE( global_row == get_global_row() );
+   BOOST_REQUIRE( !get_global_hot_state().is_null() );
+   BOOST_REQUIRE( reserved < get_global_state()["total_ram_bytes_reserved"].as_uint64() );
+   BOOST_REQUIRE_EQUAL( get_global_hot_state()["total_ram_bytes_reserved"].as_uint64(),
+                        get_global_state()["total_ram_bytes_reserved"].as_uint64() );
+
+   // changing any other field writes the whole row; setramrate also loads the hot fields, which are current in it
+   BOOST_REQUIRE_EQUAL( success(), push_action( config::system_account_name, N(setramrate), mvo()("bytes_per_block", 1000) ) );
+   BOOST_REQUIRE( global_row != get_global_row() );
+   const auto full = abi_ser.binary_to_variant( "amax_global_state", get_global_row(), abi_serializer::create_yield_function(abi_serializer_max_time) );
+   BOOST_REQUIRE_EQUAL( 1000, full["new_ram_per_block"].as<uint16_t>() );
+   BOOST_REQUIRE_EQUAL( get_global_hot_state()["total_ram_bytes_reserved"].as_uint64(), full["total_ram_bytes_reserved"].as_uint64() );
+   BOOST_REQUIRE_EQUAL( get_global_hot_state()["max_ram_size"].as_uint64(), full["max_ram_size"].as_uint64() );
+
+} FC_LOG_AND_RETHROW()
+
 BOOST_FIXTURE_TEST_CASE( eosioram_ramusage, eosio_system_tester ) try {
    BOOST_REQUIRE_EQUAL( core_sym::from_string("0.0000"), get_balance( "alice1111111" ) );
    transfer( "amax", "alice1111111", core_sym::from_string("1000.0000"), "amax" );
@@ -3728,7 +3871,7 @@ BOOST_FIXTURE_TEST_CASE( buy_sell_sell_rex, eosio_system_tester ) try {
    BOOST_REQUIRE_EQUAL( sellrex( alice, rex_tok ),                           wasm_assert_msg("insufficient funds for current and scheduled orders") );
    BOOST_REQUIRE_EQUAL( ratio * payment.get_amount() - rex_tok.get_amount(), get_rex_order( alice )["rex_requested"].as<asset>().get_amount() );
    BOOST_REQUIRE_EQUAL( success(),                                           consolidate( alice ) );
-   BOOST_REQUIRE_EQUAL( 0,                                                   get_rex_balance_obj( alice )["rex_maturities"].get_array().size() );
+   BOOST_REQUIRE_EQUAL( 0,                                                   get_rex_maturity_bucket_count( get_rex_balance_obj( alice ) ) );
 
    produce_block( fc::days(26) );
    produce_blocks(2);
@@ -4109,6 +4252,8 @@ BOOST_FIXTURE_TEST_CASE( ramfee_namebid_to_rex, eosio_system_tester ) try {
    BOOST_REQUIRE_EQUAL( success(),                        bidname( carol, N(rndmbid), core_sym::from_string("23.7000") ) );
    BOOST_REQUIRE_EQUAL( core_sym::from_string("23.7000"), get_balance( N(amax.names) ) );
    BOOST_REQUIRE_EQUAL( success(),                        bidname( alice, N(rndmbid), core_sym::from_string("29.3500") ) );
+   BOOST_REQUIRE_EQUAL( core_sym::from_string("53.0500"), get_balance( N(amax.names) ));
+   BOOST_REQUIRE_EQUAL( success(),                        bidrefund( carol, N(rndmbid) ) );
    BOOST_REQUIRE_EQUAL( core_sym::from_string("29.3500"), get_balance( N(amax.names) ));
 
    produce_block( fc::hours(24) );
@@ -4152,7 +4297,7 @@ BOOST_FIXTURE_TEST_CASE( rex_maturity, eosio_system_tester ) try {
       auto rex_balance = get_rex_balance_obj( alice );
       BOOST_REQUIRE_EQUAL( 550000 * rex_ratio, rex_balance["rex_balance"].as<asset>().get_amount() );
       BOOST_REQUIRE_EQUAL( 0,                  rex_balance["matured_rex"].as<int64_t>() );
-      BOOST_REQUIRE_EQUAL( 2,                  rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 2,                  get_rex_maturity_bucket_count( rex_balance ) );
 
       BOOST_REQUIRE_EQUAL( wasm_assert_msg("insufficient available rex"),
                            sellrex( alice, asset::from_string("115000.0000 REX") ) );
@@ -4161,7 +4306,7 @@ BOOST_FIXTURE_TEST_CASE( rex_maturity, eosio_system_tester ) try {
       rex_balance = get_rex_balance_obj( alice );
       BOOST_REQUIRE_EQUAL( 250000 * rex_ratio, rex_balance["rex_balance"].as<asset>().get_amount() );
       BOOST_REQUIRE_EQUAL( 0,                  rex_balance["matured_rex"].as<int64_t>() );
-      BOOST_REQUIRE_EQUAL( 1,                  rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 1,                  get_rex_maturity_bucket_count( rex_balance ) );
       produce_block( fc::hours(23) );
       BOOST_REQUIRE_EQUAL( wasm_assert_msg("insufficient available rex"),
                            sellrex( alice, asset::from_string("250000.0000 REX") ) );
@@ -4170,14 +4315,14 @@ BOOST_FIXTURE_TEST_CASE( rex_maturity, eosio_system_tester ) try {
       rex_balance = get_rex_balance_obj( alice );
       BOOST_REQUIRE_EQUAL( 1200000000,         rex_balance["rex_balance"].as<asset>().get_amount() );
       BOOST_REQUIRE_EQUAL( 1200000000,         rex_balance["matured_rex"].as<int64_t>() );
-      BOOST_REQUIRE_EQUAL( 0,                  rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 0,                  get_rex_maturity_bucket_count( rex_balance ) );
       BOOST_REQUIRE_EQUAL( wasm_assert_msg("insufficient available rex"),
                            sellrex( alice, asset::from_string("130000.0000 REX") ) );
       BOOST_REQUIRE_EQUAL( success(),          sellrex( alice, asset::from_string("120000.0000 REX") ) );
       rex_balance = get_rex_balance_obj( alice );
       BOOST_REQUIRE_EQUAL( 0,                  rex_balance["rex_balance"].as<asset>().get_amount() );
       BOOST_REQUIRE_EQUAL( 0,                  rex_balance["matured_rex"].as<int64_t>() );
-      BOOST_REQUIRE_EQUAL( 0,                  rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 0,                  get_rex_maturity_bucket_count( rex_balance ) );
    }
 
    {
@@ -4194,23 +4339,23 @@ BOOST_FIXTURE_TEST_CASE( rex_maturity, eosio_system_tester ) try {
 
       auto rex_balance = get_rex_balance_obj( bob );
       BOOST_REQUIRE_EQUAL( 8 * rex_bucket.get_amount(), rex_balance["rex_balance"].as<asset>().get_amount() );
-      BOOST_REQUIRE_EQUAL( 5,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 5,                           get_rex_maturity_bucket_count( rex_balance ) );
       BOOST_REQUIRE_EQUAL( 3 * rex_bucket.get_amount(), rex_balance["matured_rex"].as<int64_t>() );
 
       BOOST_REQUIRE_EQUAL( success(),                   updaterex( bob ) );
       rex_balance = get_rex_balance_obj( bob );
-      BOOST_REQUIRE_EQUAL( 4,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 4,                           get_rex_maturity_bucket_count( rex_balance ) );
       BOOST_REQUIRE_EQUAL( 4 * rex_bucket.get_amount(), rex_balance["matured_rex"].as<int64_t>() );
 
       produce_block( fc::hours(2) );
       BOOST_REQUIRE_EQUAL( success(),                   updaterex( bob ) );
       rex_balance = get_rex_balance_obj( bob );
-      BOOST_REQUIRE_EQUAL( 4,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 4,                           get_rex_maturity_bucket_count( rex_balance ) );
 
       produce_block( fc::hours(1) );
       BOOST_REQUIRE_EQUAL( success(),                   sellrex( bob, asset( 3 * rex_bucket.get_amount(), rex_sym ) ) );
       rex_balance = get_rex_balance_obj( bob );
-      BOOST_REQUIRE_EQUAL( 4,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 4,                           get_rex_maturity_bucket_count( rex_balance ) );
       BOOST_REQUIRE_EQUAL( rex_bucket.get_amount(),     rex_balance["matured_rex"].as<int64_t>() );
 
       BOOST_REQUIRE_EQUAL( wasm_assert_msg("insufficient available rex"),
@@ -4218,18 +4363,18 @@ BOOST_FIXTURE_TEST_CASE( rex_maturity, eosio_system_tester ) try {
       BOOST_REQUIRE_EQUAL( success(),                   sellrex( bob, asset( rex_bucket.get_amount(), rex_sym ) ) );
       rex_balance = get_rex_balance_obj( bob );
       BOOST_REQUIRE_EQUAL( 4 * rex_bucket.get_amount(), rex_balance["rex_balance"].as<asset>().get_amount() );
-      BOOST_REQUIRE_EQUAL( 4,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 4,                           get_rex_maturity_bucket_count( rex_balance ) );
       BOOST_REQUIRE_EQUAL( 0,                           rex_balance["matured_rex"].as<int64_t>() );
 
       produce_block( fc::hours(23) );
       BOOST_REQUIRE_EQUAL( success(),                   updaterex( bob ) );
       rex_balance = get_rex_balance_obj( bob );
-      BOOST_REQUIRE_EQUAL( 3,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 3,                           get_rex_maturity_bucket_count( rex_balance ) );
       BOOST_REQUIRE_EQUAL( rex_bucket.get_amount(),     rex_balance["matured_rex"].as<int64_t>() );
 
       BOOST_REQUIRE_EQUAL( success(),                   consolidate( bob ) );
       rex_balance = get_rex_balance_obj( bob );
-      BOOST_REQUIRE_EQUAL( 1,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 1,                           get_rex_maturity_bucket_count( rex_balance ) );
       BOOST_REQUIRE_EQUAL( 0,                           rex_balance["matured_rex"].as<int64_t>() );
 
       produce_block( fc::days(3) );
@@ -4239,7 +4384,7 @@ BOOST_FIXTURE_TEST_CASE( rex_maturity, eosio_system_tester ) try {
       BOOST_REQUIRE_EQUAL( success(),                   sellrex( bob, asset( 4 * rex_bucket.get_amount(), rex_sym ) ) );
       rex_balance = get_rex_balance_obj( bob );
       BOOST_REQUIRE_EQUAL( 0,                           rex_balance["rex_balance"].as<asset>().get_amount() );
-      BOOST_REQUIRE_EQUAL( 0,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 0,                           get_rex_maturity_bucket_count( rex_balance ) );
       BOOST_REQUIRE_EQUAL( 0,                           rex_balance["matured_rex"].as<int64_t>() );
    }
 
@@ -4301,19 +4446,19 @@ BOOST_FIXTURE_TEST_CASE( rex_savings, eosio_system_tester ) try {
 
       auto rex_balance = get_rex_balance_obj( alice );
       BOOST_REQUIRE_EQUAL( 8 * rex_bucket.get_amount(), rex_balance["rex_balance"].as<asset>().get_amount() );
-      BOOST_REQUIRE_EQUAL( 5,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 5,                           get_rex_maturity_bucket_count( rex_balance ) );
       BOOST_REQUIRE_EQUAL( 4 * rex_bucket.get_amount(), rex_balance["matured_rex"].as<int64_t>() );
 
       BOOST_REQUIRE_EQUAL( success(),                   mvtosavings( alice, asset( 8 * rex_bucket.get_amount(), rex_sym ) ) );
       rex_balance = get_rex_balance_obj( alice );
-      BOOST_REQUIRE_EQUAL( 1,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 1,                           get_rex_maturity_bucket_count( rex_balance ) );
       BOOST_REQUIRE_EQUAL( 0,                           rex_balance["matured_rex"].as<int64_t>() );
       produce_block( fc::days(1000) );
       BOOST_REQUIRE_EQUAL( wasm_assert_msg("insufficient available rex"),
                            sellrex( alice, asset::from_string( "1.0000 REX" ) ) );
       BOOST_REQUIRE_EQUAL( success(),                   mvfrsavings( alice, asset::from_string( "10.0000 REX" ) ) );
       rex_balance = get_rex_balance_obj( alice );
-      BOOST_REQUIRE_EQUAL( 2,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 2,                           get_rex_maturity_bucket_count( rex_balance ) );
       produce_block( fc::days(3) );
       BOOST_REQUIRE_EQUAL( wasm_assert_msg("insufficient available rex"),
                            sellrex( alice, asset::from_string( "1.0000 REX" ) ) );
@@ -4323,7 +4468,7 @@ BOOST_FIXTURE_TEST_CASE( rex_savings, eosio_system_tester ) try {
                            sellrex( alice, asset::from_string( "10.0001 REX" ) ) );
       BOOST_REQUIRE_EQUAL( success(),                   sellrex( alice, asset::from_string( "10.0000 REX" ) ) );
       rex_balance = get_rex_balance_obj( alice );
-      BOOST_REQUIRE_EQUAL( 1,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 1,                           get_rex_maturity_bucket_count( rex_balance ) );
       produce_block( fc::days(100) );
       BOOST_REQUIRE_EQUAL( wasm_assert_msg("insufficient available rex"),
                            sellrex( alice, asset::from_string( "0.0001 REX" ) ) );
@@ -4342,32 +4487,32 @@ BOOST_FIXTURE_TEST_CASE( rex_savings, eosio_system_tester ) try {
 
       auto rex_balance = get_rex_balance_obj( bob );
       BOOST_REQUIRE_EQUAL( 5 * rex_bucket.get_amount(), rex_balance["rex_balance"].as<asset>().get_amount() );
-      BOOST_REQUIRE_EQUAL( 5,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 5,                           get_rex_maturity_bucket_count( rex_balance ) );
       BOOST_REQUIRE_EQUAL( 0,                           rex_balance["matured_rex"].as<int64_t>() );
       BOOST_REQUIRE_EQUAL( success(),                   mvtosavings( bob, asset( rex_bucket.get_amount() / 2, rex_sym ) ) );
       rex_balance = get_rex_balance_obj( bob );
-      BOOST_REQUIRE_EQUAL( 6,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 6,                           get_rex_maturity_bucket_count( rex_balance ) );
 
       BOOST_REQUIRE_EQUAL( success(),                   mvtosavings( bob, asset( rex_bucket.get_amount() / 2, rex_sym ) ) );
       rex_balance = get_rex_balance_obj( bob );
-      BOOST_REQUIRE_EQUAL( 5,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 5,                           get_rex_maturity_bucket_count( rex_balance ) );
       produce_block( fc::days(1) );
       BOOST_REQUIRE_EQUAL( success(),                   sellrex( bob, rex_bucket ) );
       rex_balance = get_rex_balance_obj( bob );
-      BOOST_REQUIRE_EQUAL( 4,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 4,                           get_rex_maturity_bucket_count( rex_balance ) );
       BOOST_REQUIRE_EQUAL( 0,                           rex_balance["matured_rex"].as<int64_t>() );
       BOOST_REQUIRE_EQUAL( 4 * rex_bucket.get_amount(), rex_balance["rex_balance"].as<asset>().get_amount() );
 
       BOOST_REQUIRE_EQUAL( success(),                   mvtosavings( bob, asset( 3 * rex_bucket.get_amount() / 2, rex_sym ) ) );
       rex_balance = get_rex_balance_obj( bob );
-      BOOST_REQUIRE_EQUAL( 3,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 3,                           get_rex_maturity_bucket_count( rex_balance ) );
       BOOST_REQUIRE_EQUAL( wasm_assert_msg("insufficient available rex"),
                            sellrex( bob, rex_bucket ) );
 
       produce_block( fc::days(1) );
       BOOST_REQUIRE_EQUAL( success(),                   sellrex( bob, rex_bucket ) );
       rex_balance = get_rex_balance_obj( bob );
-      BOOST_REQUIRE_EQUAL( 2,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 2,                           get_rex_maturity_bucket_count( rex_balance ) );
       BOOST_REQUIRE_EQUAL( 0,                           rex_balance["matured_rex"].as<int64_t>() );
       BOOST_REQUIRE_EQUAL( 3 * rex_bucket.get_amount(), rex_balance["rex_balance"].as<asset>().get_amount() );
 
@@ -4376,7 +4521,7 @@ BOOST_FIXTURE_TEST_CASE( rex_savings, eosio_system_tester ) try {
                            sellrex( bob, rex_bucket ) );
       BOOST_REQUIRE_EQUAL( success(),                   sellrex( bob, asset( rex_bucket.get_amount() / 2, rex_sym ) ) );
       rex_balance = get_rex_balance_obj( bob );
-      BOOST_REQUIRE_EQUAL( 1,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 1,                           get_rex_maturity_bucket_count( rex_balance ) );
       BOOST_REQUIRE_EQUAL( 0,                           rex_balance["matured_rex"].as<int64_t>() );
       BOOST_REQUIRE_EQUAL( 5 * rex_bucket.get_amount(), 2 * rex_balance["rex_balance"].as<asset>().get_amount() );
 
@@ -4386,12 +4531,12 @@ BOOST_FIXTURE_TEST_CASE( rex_savings, eosio_system_tester ) try {
       BOOST_REQUIRE_EQUAL( wasm_assert_msg("insufficient REX in savings"),
                            mvfrsavings( bob, asset( 3 * rex_bucket.get_amount(), rex_sym ) ) );
       BOOST_REQUIRE_EQUAL( success(),                   mvfrsavings( bob, rex_bucket ) );
-      BOOST_REQUIRE_EQUAL( 2,                           get_rex_balance_obj( bob )["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 2,                           get_rex_maturity_bucket_count( get_rex_balance_obj( bob ) ) );
       BOOST_REQUIRE_EQUAL( wasm_assert_msg("insufficient REX balance"),
                            mvtosavings( bob, asset( 3 * rex_bucket.get_amount() / 2, rex_sym ) ) );
       produce_block( fc::days(1) );
       BOOST_REQUIRE_EQUAL( success(),                   mvfrsavings( bob, rex_bucket ) );
-      BOOST_REQUIRE_EQUAL( 3,                           get_rex_balance_obj( bob )["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 3,                           get_rex_maturity_bucket_count( get_rex_balance_obj( bob ) ) );
       produce_block( fc::days(4) );
       BOOST_REQUIRE_EQUAL( success(),                   sellrex( bob, rex_bucket ) );
       BOOST_REQUIRE_EQUAL( wasm_assert_msg("insufficient available rex"),
@@ -4399,22 +4544,22 @@ BOOST_FIXTURE_TEST_CASE( rex_savings, eosio_system_tester ) try {
       produce_block( fc::days(1) );
       BOOST_REQUIRE_EQUAL( success(),                   sellrex( bob, rex_bucket ) );
       rex_balance = get_rex_balance_obj( bob );
-      BOOST_REQUIRE_EQUAL( 1,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 1,                           get_rex_maturity_bucket_count( rex_balance ) );
       BOOST_REQUIRE_EQUAL( rex_bucket.get_amount() / 2, rex_balance["rex_balance"].as<asset>().get_amount() );
 
       BOOST_REQUIRE_EQUAL( success(),                   mvfrsavings( bob, asset( rex_bucket.get_amount() / 4, rex_sym ) ) );
       produce_block( fc::days(2) );
       BOOST_REQUIRE_EQUAL( success(),                   mvfrsavings( bob, asset( rex_bucket.get_amount() / 8, rex_sym ) ) );
-      BOOST_REQUIRE_EQUAL( 3,                           get_rex_balance_obj( bob )["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 3,                           get_rex_maturity_bucket_count( get_rex_balance_obj( bob ) ) );
       BOOST_REQUIRE_EQUAL( success(),                   consolidate( bob ) );
-      BOOST_REQUIRE_EQUAL( 2,                           get_rex_balance_obj( bob )["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 2,                           get_rex_maturity_bucket_count( get_rex_balance_obj( bob ) ) );
 
       produce_block( fc::days(5) );
       BOOST_REQUIRE_EQUAL( wasm_assert_msg("insufficient available rex"),
                            sellrex( bob, asset( rex_bucket.get_amount() / 2, rex_sym ) ) );
       BOOST_REQUIRE_EQUAL( success(),                   sellrex( bob, asset( 3 * rex_bucket.get_amount() / 8, rex_sym ) ) );
       rex_balance = get_rex_balance_obj( bob );
-      BOOST_REQUIRE_EQUAL( 1,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 1,                           get_rex_maturity_bucket_count( rex_balance ) );
       BOOST_REQUIRE_EQUAL( 0,                           rex_balance["matured_rex"].as<int64_t>() );
       BOOST_REQUIRE_EQUAL( rex_bucket.get_amount() / 8, rex_balance["rex_balance"].as<asset>().get_amount() );
       BOOST_REQUIRE_EQUAL( success(),                   mvfrsavings( bob, get_rex_balance( bob ) ) );
@@ -4459,21 +4604,21 @@ BOOST_FIXTURE_TEST_CASE( rex_savings, eosio_system_tester ) try {
       BOOST_REQUIRE_EQUAL( rex_bucket,                  get_rex_balance( carol ) );
       auto rex_balance = get_rex_balance_obj( carol );
 
-      BOOST_REQUIRE_EQUAL( 1,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 1,                           get_rex_maturity_bucket_count( rex_balance ) );
       BOOST_REQUIRE_EQUAL( 0,                           rex_balance["matured_rex"].as<int64_t>() );
       produce_block( fc::days(1) );
       BOOST_REQUIRE_EQUAL( success(),                   buyrex( carol, payment ) );
       rex_balance = get_rex_balance_obj( carol );
-      BOOST_REQUIRE_EQUAL( 2,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 2,                           get_rex_maturity_bucket_count( rex_balance ) );
       BOOST_REQUIRE_EQUAL( 0,                           rex_balance["matured_rex"].as<int64_t>() );
 
       BOOST_REQUIRE_EQUAL( success(),                   mvtosavings( carol, half_rex_bucket ) );
       rex_balance = get_rex_balance_obj( carol );
-      BOOST_REQUIRE_EQUAL( 3,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 3,                           get_rex_maturity_bucket_count( rex_balance ) );
 
       BOOST_REQUIRE_EQUAL( success(),                   buyrex( carol, half_payment ) );
       rex_balance = get_rex_balance_obj( carol );
-      BOOST_REQUIRE_EQUAL( 3,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 3,                           get_rex_maturity_bucket_count( rex_balance ) );
 
       produce_block( fc::days(5) );
       BOOST_REQUIRE_EQUAL( wasm_assert_msg("asset must be a positive amount of (REX, 4)"),
@@ -4484,7 +4629,7 @@ BOOST_FIXTURE_TEST_CASE( rex_savings, eosio_system_tester ) try {
       BOOST_REQUIRE_EQUAL( wasm_assert_msg("insufficient REX in savings"),
                            mvfrsavings( carol, asset::from_string("0.0001 REX") ) );
       rex_balance = get_rex_balance_obj( carol );
-      BOOST_REQUIRE_EQUAL( 1,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 1,                           get_rex_maturity_bucket_count( rex_balance ) );
       BOOST_REQUIRE_EQUAL( 5 * half_rex_bucket_amount,  rex_balance["rex_balance"].as<asset>().get_amount() );
       BOOST_REQUIRE_EQUAL( 2 * rex_bucket_amount,       rex_balance["matured_rex"].as<int64_t>() );
       produce_block( fc::days(5) );
@@ -4862,7 +5007,7 @@ BOOST_FIXTURE_TEST_CASE( rex_return, eosio_system_tester ) try {
       auto rex_return_pool = get_rex_return_pool();
       BOOST_REQUIRE_EQUAL( false,            rex_return_pool.is_null() );
       BOOST_REQUIRE_EQUAL( 0,                rex_return_pool["current_rate_of_increase"].as<int64_t>() );
-      BOOST_REQUIRE_EQUAL( 0,                get_rex_return_buckets()["return_buckets"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 0,                get_rex_return_bucket_count() );
       BOOST_REQUIRE_EQUAL( expected_pending_bucket_time.sec_since_epoch(),
                            rex_return_pool["pending_bucket_time"].as<time_point_sec>().sec_since_epoch() );
       int32_t t0 = rex_return_pool["pending_bucket_time"].as<time_point_sec>().sec_since_epoch();
@@ -4885,7 +5030,7 @@ BOOST_FIXTURE_TEST_CASE( rex_return, eosio_system_tester ) try {
       BOOST_REQUIRE_EQUAL( success(),        rexexec( bob, 1 ) );
       rex_return_pool = get_rex_return_pool();
       BOOST_REQUIRE_EQUAL( rate,             rex_return_pool["current_rate_of_increase"].as<int64_t>() );
-      BOOST_REQUIRE_EQUAL( 1,                get_rex_return_buckets()["return_buckets"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 1,                get_rex_return_bucket_count() );
       int64_t t2 = rex_return_pool["last_dist_time"].as<time_point_sec>().sec_since_epoch();
       change      = rate * ((t2-t0) / dist_interval) + fee.get_amount() % total_intervals;
       expected    = payment.get_amount() + change;
@@ -4899,7 +5044,7 @@ BOOST_FIXTURE_TEST_CASE( rex_return, eosio_system_tester ) try {
 
       rex_return_pool = get_rex_return_pool();
       BOOST_REQUIRE_EQUAL( 0,                rex_return_pool["current_rate_of_increase"].as<int64_t>() );
-      BOOST_REQUIRE_EQUAL( 0,                get_rex_return_buckets()["return_buckets"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 0,                get_rex_return_bucket_count() );
 
       rex_pool = get_rex_pool();
       expected = payment.get_amount() + fee.get_amount();
@@ -4920,14 +5065,14 @@ BOOST_FIXTURE_TEST_CASE( rex_return, eosio_system_tester ) try {
       BOOST_REQUIRE_EQUAL( success(),        rentnet( bob, bob, fee ) );
       rex_return_pool = get_rex_return_pool();
       BOOST_REQUIRE_EQUAL( 0,                rex_return_pool["current_rate_of_increase"].as<int64_t>() );
-      BOOST_REQUIRE_EQUAL( 0,                get_rex_return_buckets()["return_buckets"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 0,                get_rex_return_bucket_count() );
       uint32_t t1 = rex_return_pool["last_dist_time"].as<time_point_sec>().sec_since_epoch();
       BOOST_REQUIRE_EQUAL( t1,               t0 + 6 * dist_interval );
 
       produce_block( fc::hours(12) );
       BOOST_REQUIRE_EQUAL( success(),        rentnet( bob, bob, fee ) );
       rex_return_pool = get_rex_return_pool();
-      BOOST_REQUIRE_EQUAL( 1,                get_rex_return_buckets()["return_buckets"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 1,                get_rex_return_bucket_count() );
       int64_t rate = 2 * fee.get_amount() / total_intervals;
       BOOST_REQUIRE_EQUAL( rate,             rex_return_pool["current_rate_of_increase"].as<int64_t>() );
       produce_block( fc::hours(8) );
@@ -4945,7 +5090,7 @@ BOOST_FIXTURE_TEST_CASE( rex_return, eosio_system_tester ) try {
       BOOST_REQUIRE_EQUAL( success(),        rexexec( bob, 1 ) );
       rex_return_pool = get_rex_return_pool();
       BOOST_REQUIRE_EQUAL( 0,                rex_return_pool["current_rate_of_increase"].as<int64_t>() );
-      BOOST_REQUIRE_EQUAL( 0,                get_rex_return_buckets()["return_buckets"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 0,                get_rex_return_bucket_count() );
       BOOST_REQUIRE_EQUAL( init_lendable.get_amount() + 3 * fee.get_amount(),
                            get_rex_pool()["total_lendable"].as<asset>().get_amount() );
    }
@@ -4976,7 +5121,7 @@ BOOST_FIXTURE_TEST_CASE( rex_return, eosio_system_tester ) try {
       produce_block( fc::days(31) );
       produce_blocks( 1 );
       BOOST_REQUIRE_EQUAL( success(),        rexexec( bob, 1 ) );
-      BOOST_REQUIRE_EQUAL( 0,                get_rex_return_buckets()["return_buckets"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 0,                get_rex_return_bucket_count() );
       BOOST_REQUIRE_EQUAL( 0,                get_rex_return_pool()["current_rate_of_increase"].as<int64_t>() );
    }
 
@@ -4987,10 +5132,10 @@ BOOST_FIXTURE_TEST_CASE( rex_return, eosio_system_tester ) try {
          produce_block( fc::days(1) );
       }
       BOOST_REQUIRE_EQUAL( success(),        rexexec( bob, 1 ) );
-      BOOST_REQUIRE_EQUAL( 5,                get_rex_return_buckets()["return_buckets"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 5,                get_rex_return_bucket_count() );
       produce_block( fc::days(30) );
       BOOST_REQUIRE_EQUAL( success(),        rexexec( bob, 1 ) );
-      BOOST_REQUIRE_EQUAL( 0,                get_rex_return_buckets()["return_buckets"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 0,                get_rex_return_bucket_count() );
    }
 
 } FC_LOG_AND_RETHROW()
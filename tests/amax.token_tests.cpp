@@ -100,6 +100,73 @@ public:
       );
    }
 
+   action_result transfers( account_name from,
+                            const vector<std::tuple<account_name, string, string>>& payments ) {
+      vector<mvo> items;
+      for( const auto& p : payments ) {
+         items.push_back( mvo()
+            ( "to", std::get<0>(p) )
+            ( "quantity", std::get<1>(p) )
+            ( "memo", std::get<2>(p) )
+         );
+      }
+      return push_action( from, N(transfers), mvo()
+           ( "from", from)
+           ( "transfers", items)
+      );
+   }
+
+   fc::variant get_airdrop( uint64_t airdrop_id )
+   {
+      vector<char> data = get_row_by_account( N(amax.token), N(amax.token), N(airdrops), account_name(airdrop_id) );
+      return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "airdrop", data, abi_serializer::create_yield_function(abi_serializer_max_time) );
+   }
+
+   static fc::sha256 airdrop_leaf( uint64_t index, account_name to, const asset& quantity ) {
+      fc::sha256::encoder enc;
+      fc::raw::pack( enc, index );
+      fc::raw::pack( enc, to );
+      fc::raw::pack( enc, quantity );
+      return enc.result();
+   }
+
+   static fc::sha256 airdrop_node( const fc::sha256& a, const fc::sha256& b ) {
+      const bool a_first = memcmp( a.data(), b.data(), a.data_size() ) < 0;
+      fc::sha256::encoder enc;
+      enc.write( (a_first ? a : b).data(), a.data_size() );
+      enc.write( (a_first ? b : a).data(), b.data_size() );
+      return enc.result();
+   }
+
+   action_result newairdrop( account_name issuer, const fc::sha256& root, asset total ) {
+      return push_action( issuer, N(newairdrop), mvo()
+           ( "root", root )
+           ( "total", total )
+      );
+   }
+
+   action_result claimairdrop( account_name payer, uint64_t airdrop_id, const vector<mvo>& claims ) {
+      return push_action( payer, N(claimairdrop), mvo()
+           ( "payer", payer )
+           ( "airdrop_id", airdrop_id )
+           ( "claims", claims )
+      );
+   }
+
+   static mvo airdrop_claim( uint64_t index, account_name to, const asset& quantity, const vector<fc::sha256>& proof ) {
+      return mvo()
+         ( "index", index )
+         ( "to", to )
+         ( "quantity", quantity )
+         ( "proof", proof );
+   }
+
+   action_result closeairdrop( account_name issuer, uint64_t airdrop_id ) {
+      return push_action( issuer, N(closeairdrop), mvo()
+           ( "airdrop_id", airdrop_id )
+      );
+   }
+
    action_result open( account_name owner,
                        const string& symbolname,
                        account_name ram_payer    ) {
@@ -346,6 +413,123 @@ BOOST_FIXTURE_TEST_CASE( transfer_tests, eosio_token_tester ) try {
 
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE( transfers_tests, eosio_token_tester ) try {
+
+   create( N(alice), asset::from_string("1000 CERO"));
+   produce_blocks(1);
+
+   issue( N(alice), asset::from_string("1000 CERO"), "hola" );
+
+   BOOST_REQUIRE_EQUAL( success(), transfers( N(alice), {
+      { N(bob),   "300 CERO", "hola" },
+      { N(carol), "200 CERO", "" },
+      { N(bob),   "100 CERO", "again" }
+   } ) );
+
+   REQUIRE_MATCHING_OBJECT( get_account(N(alice), "0,CERO"), mvo()
+      ("balance", "400 CERO")
+   );
+   REQUIRE_MATCHING_OBJECT( get_account(N(bob), "0,CERO"), mvo()
+      ("balance", "400 CERO")
+   );
+   REQUIRE_MATCHING_OBJECT( get_account(N(carol), "0,CERO"), mvo()
+      ("balance", "200 CERO")
+   );
+
+   // the whole batch is debited at once, a sum above the balance fails every payment
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "overdrawn balance" ),
+      transfers( N(alice), { { N(bob), "300 CERO", "" }, { N(carol), "101 CERO", "" } } )
+   );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "must transfer positive quantity" ),
+      transfers( N(alice), { { N(bob), "1 CERO", "" }, { N(carol), "0 CERO", "" } } )
+   );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "cannot transfer to self" ),
+      transfers( N(alice), { { N(alice), "1 CERO", "" } } )
+   );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "to account does not exist" ),
+      transfers( N(alice), { { N(nonexistent), "1 CERO", "" } } )
+   );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "no transfers" ),
+      transfers( N(alice), {} )
+   );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "missing authority of either bob or amax.bootdao" ),
+      push_action( N(alice), N(transfers), mvo()
+         ( "from", "bob" )
+         ( "transfers", vector<mvo>{ mvo()("to", "carol")("quantity", "1 CERO")("memo", "") } )
+      )
+   );
+
+   REQUIRE_MATCHING_OBJECT( get_account(N(alice), "0,CERO"), mvo()
+      ("balance", "400 CERO")
+   );
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( airdrop_tests, eosio_token_tester ) try {
+
+   create( N(alice), asset::from_string("1000 CERO"));
+   produce_blocks(1);
+
+   issue( N(alice), asset::from_string("1000 CERO"), "hola" );
+
+   // three payments: root = node( node( leaf0, leaf1 ), leaf2 )
+   const auto leaf0 = airdrop_leaf( 0, N(bob),   asset::from_string("100 CERO") );
+   const auto leaf1 = airdrop_leaf( 1, N(carol), asset::from_string("200 CERO") );
+   const auto leaf2 = airdrop_leaf( 2, N(bob),   asset::from_string("50 CERO") );
+   const auto node01 = airdrop_node( leaf0, leaf1 );
+   const auto root = airdrop_node( node01, leaf2 );
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "overdrawn balance" ),
+      newairdrop( N(alice), root, asset::from_string("1001 CERO") )
+   );
+   BOOST_REQUIRE_EQUAL( success(), newairdrop( N(alice), root, asset::from_string("400 CERO") ) );
+   REQUIRE_MATCHING_OBJECT( get_account(N(alice), "0,CERO"), mvo()
+      ("balance", "600 CERO")
+   );
+
+   // carol claims for both bob and herself, nobody had a balance row before
+   BOOST_REQUIRE( get_account(N(bob), "0,CERO").is_null() );
+   BOOST_REQUIRE_EQUAL( success(), claimairdrop( N(carol), 0, {
+      airdrop_claim( 0, N(bob),   asset::from_string("100 CERO"), { leaf1, leaf2 } ),
+      airdrop_claim( 1, N(carol), asset::from_string("200 CERO"), { leaf0, leaf2 } )
+   } ) );
+   REQUIRE_MATCHING_OBJECT( get_account(N(bob), "0,CERO"), mvo()
+      ("balance", "100 CERO")
+   );
+   REQUIRE_MATCHING_OBJECT( get_account(N(carol), "0,CERO"), mvo()
+      ("balance", "200 CERO")
+   );
+   BOOST_REQUIRE_EQUAL( "100 CERO", get_airdrop(0)["remaining"].as_string() );
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "airdrop already claimed" ),
+      claimairdrop( N(bob), 0, { airdrop_claim( 0, N(bob), asset::from_string("100 CERO"), { leaf1, leaf2 } ) } )
+   );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "invalid airdrop proof" ),
+      claimairdrop( N(bob), 0, { airdrop_claim( 2, N(bob), asset::from_string("60 CERO"), { node01 } ) } )
+   );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "airdrop does not exist" ),
+      claimairdrop( N(bob), 1, { airdrop_claim( 2, N(bob), asset::from_string("50 CERO"), { node01 } ) } )
+   );
+   BOOST_REQUIRE_EQUAL( success(),
+      claimairdrop( N(bob), 0, { airdrop_claim( 2, N(bob), asset::from_string("50 CERO"), { node01 } ) } )
+   );
+   REQUIRE_MATCHING_OBJECT( get_account(N(bob), "0,CERO"), mvo()
+      ("balance", "150 CERO")
+   );
+
+   // the unclaimed tokens go back to the issuer
+   BOOST_REQUIRE_EQUAL( error( "missing authority of alice" ), closeairdrop( N(bob), 0 ) );
+   BOOST_REQUIRE_EQUAL( success(), closeairdrop( N(alice), 0 ) );
+   REQUIRE_MATCHING_OBJECT( get_account(N(alice), "0,CERO"), mvo()
+      ("balance", "650 CERO")
+   );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "airdrop is closed" ),
+      claimairdrop( N(bob), 0, { airdrop_claim( 2, N(bob), asset::from_string("50 CERO"), { node01 } ) } )
+   );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "airdrop is closed" ), closeairdrop( N(alice), 0 ) );
+
+} FC_LOG_AND_RETHROW()
+
 BOOST_FIXTURE_TEST_CASE( open_tests, eosio_token_tester ) try {
 
    auto token = create( N(alice), asset::from_string("1000 CERO"));